@@ -22,7 +22,8 @@
 layout(location = 0) out vec4 fragColour;
 
 layout(location = 0) in vec2 texCoord_;
+layout(location = 1) in vec4 colour_;
 
 uniform sampler2D tex;
 
-void main() { fragColour = texture(tex, texCoord_); }
\ No newline at end of file
+void main() { fragColour = texture(tex, texCoord_) * colour_; }
\ No newline at end of file
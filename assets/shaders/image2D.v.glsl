@@ -21,10 +21,15 @@
 
 layout(location = 0) in vec2 pos;
 layout(location = 1) in vec2 texCoord;
+layout(location = 2) in vec4 colour;
 
 layout(location = 0) out vec2 texCoord_;
+layout(location = 1) out vec4 colour_;
+
+layout(std140, binding = 0) uniform View { mat4 projection; };
 
 void main() {
-  gl_Position = vec4(pos, 0.0, 1.0);
+  gl_Position = projection * vec4(pos, 0.0, 1.0);
   texCoord_ = texCoord;
+  colour_ = colour;
 }
\ No newline at end of file
@@ -21,6 +21,6 @@
 
 layout(location = 0) out vec4 fragColour;
 
-uniform vec4 colour;
+layout(location = 1) in vec4 colour_;
 
-void main() { fragColour = vec4(colour); }
\ No newline at end of file
+void main() { fragColour = colour_; }
\ No newline at end of file
@@ -20,5 +20,13 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 layout(location = 0) in vec2 pos;
+layout(location = 2) in vec4 colour;
 
-void main() { gl_Position = vec4(pos, 0.0, 1.0); }
\ No newline at end of file
+layout(location = 1) out vec4 colour_;
+
+layout(std140, binding = 0) uniform View { mat4 projection; };
+
+void main() {
+  gl_Position = projection * vec4(pos, 0.0, 1.0);
+  colour_ = colour;
+}
\ No newline at end of file
@@ -22,10 +22,14 @@
 layout(location = 0) out vec4 fragColour;
 
 layout(location = 0) in vec2 texCoord_;
+layout(location = 1) in vec4 colour_;
 
+// signed distance field - 0.5 is the outline, larger is inside
 uniform sampler2D tex;
-uniform vec4 colour;
 
 void main() {
-  fragColour = vec4(colour.rgb, texture(tex, texCoord_).r * colour.a);
+  float field = texture(tex, texCoord_).r;
+  float width = fwidth(field);
+  float coverage = smoothstep(0.5 - width, 0.5 + width, field);
+  fragColour = vec4(colour_.rgb, coverage * colour_.a);
 }
\ No newline at end of file
@@ -0,0 +1,166 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// allocator benchmark - pool and arena against the heap, for the churn of
+// short-lived objects and per-tick scratch buffers, on one thread and on
+// every thread at once, where the heap contends
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "util/arena.h"
+#include "util/pool.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace carrier_conquest::util;
+
+namespace {
+constexpr size_t LIVE = 10'000;    // objects alive at once
+constexpr size_t CHURN = 100'000;  // objects replaced per thread
+constexpr size_t TICKS = 1'000;
+constexpr size_t SCRATCH = 20'000;  // floats per scratch buffer
+
+// about the size of a projectile's components
+struct Object final {
+  float x;
+  float y;
+  float vx;
+  float vy;
+  uint64_t target;
+  float lifetime;
+};
+
+double heapChurn(uint32_t seed) {
+  mt19937 random(seed);
+  vector<unique_ptr<Object>> live;
+  for (size_t index = 0; index < LIVE; ++index)
+    live.push_back(make_unique<Object>());
+  steady_clock::time_point start = steady_clock::now();
+  for (size_t index = 0; index < CHURN; ++index)
+    live[random() % LIVE] = make_unique<Object>();
+  return duration<double, nano>(steady_clock::now() - start).count() /
+         static_cast<double>(CHURN);
+}
+
+double poolChurn(uint32_t seed, AllocatorStats &stats) {
+  mt19937 random(seed);
+  Pool<Object> pool;
+  vector<Pool<Object>::Handle> live;
+  for (size_t index = 0; index < LIVE; ++index)
+    live.push_back(pool.create());
+  steady_clock::time_point start = steady_clock::now();
+  for (size_t index = 0; index < CHURN; ++index) {
+    Pool<Object>::Handle &handle = live[random() % LIVE];
+    pool.destroy(handle);
+    handle = pool.create();
+  }
+  double time = duration<double, nano>(steady_clock::now() - start).count() /
+                static_cast<double>(CHURN);
+  stats = pool.getStats();
+  return time;
+}
+
+// touches a line in every page or so, so allocation isn't lost in the noise
+float use(span<float> scratch) {
+  for (size_t index = 0; index < scratch.size(); index += 1024)
+    scratch[index] = static_cast<float>(index);
+  return scratch[scratch.size() / 2];
+}
+
+double heapScratch() {
+  float sink = 0.0f;
+  steady_clock::time_point start = steady_clock::now();
+  for (size_t tick = 0; tick < TICKS; ++tick) {
+    vector<float> scratch(SCRATCH);
+    sink += use(scratch);
+  }
+  return duration<double, nano>(steady_clock::now() - start).count() /
+             static_cast<double>(TICKS) +
+         (sink < 0.0f ? 1.0 : 0.0);
+}
+
+double arenaScratch(AllocatorStats &stats) {
+  float sink = 0.0f;
+  steady_clock::time_point start = steady_clock::now();
+  for (size_t tick = 0; tick < TICKS; ++tick) {
+    Arena::Scope scope(threadArena());
+    sink += use(threadArena().allocate<float>(SCRATCH));
+  }
+  double time = duration<double, nano>(steady_clock::now() - start).count() /
+                    static_cast<double>(TICKS) +
+                (sink < 0.0f ? 1.0 : 0.0);
+  stats = threadArena().getStats();
+  return time;
+}
+
+// slowest thread's time, with every thread running f at once
+template <typename F>
+double onEveryThread(unsigned threads, F const &f) {
+  vector<double> times(threads);
+  {
+    vector<jthread> workers;
+    for (unsigned thread = 0; thread < threads; ++thread)
+      workers.emplace_back([&, thread]() { times[thread] = f(thread); });
+  }
+  return *max_element(times.begin(), times.end());
+}
+}  // namespace
+
+int main() {
+  unsigned threads = max(thread::hardware_concurrency(), 1u);
+  AllocatorStats poolStats{};
+  AllocatorStats arenaStats{};
+  printf("nanoseconds per object replaced, or per scratch buffer\n");
+  printf("%8s %10s %10s %10s %10s\n", "threads", "heap", "pool", "heap",
+         "arena");
+  for (unsigned count : {1u, threads}) {
+    double heap = onEveryThread(count, heapChurn);
+    double pool = onEveryThread(count, [&](unsigned thread) {
+      AllocatorStats stats;
+      double time = poolChurn(thread, stats);
+      if (thread == 0) poolStats = stats;
+      return time;
+    });
+    double heapBuffers = onEveryThread(count, [](unsigned) {
+      return heapScratch();
+    });
+    double arenaBuffers = onEveryThread(count, [&](unsigned thread) {
+      AllocatorStats stats;
+      double time = arenaScratch(stats);
+      if (thread == 0) arenaStats = stats;
+      return time;
+    });
+    printf("%8u %10.1f %10.1f %10.1f %10.1f\n", count, heap, pool,
+           heapBuffers, arenaBuffers);
+    if (count == threads) break;
+  }
+  printf("pool: %zu live, %zu at most, %zu slots\n", poolStats.used,
+         poolStats.highWater, poolStats.capacity);
+  printf("arena: %zu bytes used, %zu at most, %zu reserved\n",
+         arenaStats.used, arenaStats.highWater, arenaStats.capacity);
+  return 0;
+}
@@ -0,0 +1,107 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// deterministic maths benchmark - sinCos against libm, its worst error over a
+// sweep of angles, and a hash of its results to compare between builds
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+#include "game/detMath.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace carrier_conquest::game;
+
+namespace {
+constexpr size_t COUNT = 1'000'000;
+constexpr double PI = 3.141592653589793238462643383279502884;
+
+// distance in representable floats, for values of the same sign
+int64_t ulps(float a, float b) noexcept {
+  int32_t bitsA;
+  int32_t bitsB;
+  memcpy(&bitsA, &a, sizeof(float));
+  memcpy(&bitsB, &b, sizeof(float));
+  return llabs(static_cast<int64_t>(bitsA) - bitsB);
+}
+
+template <typename F>
+double nanosecondsPer(F const &f) {
+  steady_clock::time_point start = steady_clock::now();
+  f();
+  return duration<double, nano>(steady_clock::now() - start).count() /
+         static_cast<double>(COUNT);
+}
+}  // namespace
+
+int main() {
+  vector<Angle> angles(COUNT);
+  vector<float> radians(COUNT);
+  for (size_t index = 0; index < COUNT; ++index) {
+    // an odd stride visits every table entry at many offsets
+    angles[index] = static_cast<Angle>(index * 2'654'435'761u);
+    radians[index] = static_cast<float>(angles[index] * (2.0 * PI / 0x1p32));
+  }
+  vector<float> sines(COUNT);
+  vector<float> cosines(COUNT);
+
+  double tableTime = nanosecondsPer([&]() {
+    for (size_t index = 0; index < COUNT; ++index) {
+      SinCos result = sinCos(angles[index]);
+      sines[index] = result.sin;
+      cosines[index] = result.cos;
+    }
+  });
+  uint32_t hash = 0;
+  int64_t worst = 0;
+  for (size_t index = 0; index < COUNT; ++index) {
+    double exact = angles[index] * (2.0 * PI / 0x1p32);
+    for (auto [value, expected] : {pair(sines[index], sin(exact)),
+                                   pair(cosines[index], cos(exact))}) {
+      // near zero, relative error means little
+      if (fabs(expected) > 1e-3)
+        worst = max(worst, ulps(value, static_cast<float>(expected)));
+      uint32_t bits;
+      memcpy(&bits, &value, sizeof(float));
+      hash = hash * 31 + bits;
+    }
+  }
+
+  double libmTime = nanosecondsPer([&]() {
+    for (size_t index = 0; index < COUNT; ++index) {
+      sines[index] = sin(radians[index]);
+      cosines[index] = cos(radians[index]);
+    }
+  });
+
+  printf("nanoseconds per sin and cos\n");
+  printf("%10s %10s %10s %10s\n", "sinCos", "libm", "worst ulp", "hash");
+  printf("%10.2f %10.2f %10lld %10.8x\n", tableTime, libmTime,
+         static_cast<long long>(worst), hash);
+  return 0;
+}
@@ -0,0 +1,126 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// navigation benchmark - building the sector graph, moving one obstacle,
+// answering path queries cold and from the cache, and building flow fields,
+// against the number of obstacles on the map
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "game/entity.h"
+#include "game/navigation.h"
+#include "util/jobSystem.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace carrier_conquest::game;
+using namespace carrier_conquest::util;
+
+namespace {
+constexpr float MAP_SIZE = 1'000'000.0f;  // metres, as in GameState
+constexpr size_t QUERIES = 1'024;
+constexpr size_t FIELDS = 8;
+
+double millisecondsSince(steady_clock::time_point start) {
+  return duration<double, milli>(steady_clock::now() - start).count();
+}
+
+void run(uint32_t obstacles) {
+  mt19937 random(obstacles);
+  uniform_real_distribution<float> coordinate(0.0f, MAP_SIZE);
+  uniform_real_distribution<float> radius(2'000.0f, 20'000.0f);
+
+  Navigation navigation;
+  for (uint32_t index = 0; index < obstacles; ++index)
+    navigation.setObstacle(Entity{index, 0}, coordinate(random),
+                           coordinate(random), radius(random));
+  steady_clock::time_point start = steady_clock::now();
+  navigation.update();
+  double build = millisecondsSince(start);
+
+  struct Query final {
+    float fromX;
+    float fromY;
+    float toX;
+    float toY;
+  };
+  vector<Query> queries;
+  for (size_t index = 0; index < QUERIES; ++index)
+    queries.push_back(Query{coordinate(random), coordinate(random),
+                            coordinate(random), coordinate(random)});
+
+  // every query is answered by the time the last one is
+  auto answerAll = [&]() {
+    Navigation::Ticket last = 0;
+    for (Query const &query : queries)
+      last = navigation.requestPath(query.fromX, query.fromY, query.toX,
+                                    query.toY);
+    size_t ticks = 0;
+    for (; !navigation.takePath(last).has_value(); ++ticks) navigation.update();
+    return ticks;
+  };
+  start = steady_clock::now();
+  size_t ticks = answerAll();
+  double cold = millisecondsSince(start) * 1e3 / QUERIES;
+  start = steady_clock::now();
+  answerAll();
+  double cached = millisecondsSince(start) * 1e3 / QUERIES;
+
+  // moved within its cells, then far enough to change some
+  Entity moved{0, 0};
+  float x = coordinate(random);
+  float y = coordinate(random);
+  navigation.setObstacle(moved, x, y, 10'000.0f);
+  navigation.update();
+  start = steady_clock::now();
+  navigation.setObstacle(moved, x + 1.0f, y, 10'000.0f);
+  navigation.update();
+  double nudge = millisecondsSince(start);
+  start = steady_clock::now();
+  navigation.setObstacle(moved, x + 20'000.0f, y, 10'000.0f);
+  navigation.update();
+  double shift = millisecondsSince(start);
+
+  start = steady_clock::now();
+  for (size_t index = 0; index < FIELDS; ++index) {
+    float goalX = coordinate(random);
+    float goalY = coordinate(random);
+    while (navigation.flowField(goalX, goalY) == nullptr) navigation.update();
+  }
+  double field = millisecondsSince(start) / FIELDS;
+
+  printf("%9u %10.2f %10.2f %10.2f %6zu %10.3f %10.3f %10.2f\n", obstacles,
+         build, cold, cached, ticks, nudge, shift, field);
+}
+}  // namespace
+
+int main() {
+  jobs = make_unique<JobSystem>();
+  printf("%9s %10s %10s %10s %6s %10s %10s %10s\n", "obstacles", "build ms",
+         "cold us", "cached us", "ticks", "nudge ms", "shift ms", "field ms");
+  run(0);
+  for (uint32_t obstacles = 64; obstacles <= 1'024; obstacles *= 4)
+    run(obstacles);
+  return 0;
+}
@@ -0,0 +1,153 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// projectile kernel benchmark - time per tick for each version of the kernel,
+// checking they all agree bit for bit, and for the whole projectile system
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "game/projectileKernel.h"
+#include "game/projectiles.h"
+#include "game/world.h"
+#include "util/jobSystem.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace carrier_conquest::game;
+using namespace carrier_conquest::util;
+
+namespace {
+constexpr float TICK = 1.0f / 20.0f;  // seconds, as in GameState
+constexpr size_t TICKS = 100;
+constexpr size_t TARGETS = 100;
+
+using Kernel = void (*)(ProjectileLanes const &, size_t, size_t, float);
+
+struct Volley final {
+  explicit Volley(size_t count) : floats(count * 9), flags(count) {
+    mt19937 random(static_cast<uint32_t>(count));
+    uniform_real_distribution<float> coordinate(0.0f, 100'000.0f);
+    uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    for (size_t index = 0; index < count; ++index) {
+      float heading = angle(random);
+      float turn = index % 4 == 0 ? 0.0f : 0.5f * TICK;  // some unguided
+      lane(0, count)[index] = coordinate(random);
+      lane(1, count)[index] = coordinate(random);
+      lane(2, count)[index] = 300.0f * cos(heading);
+      lane(3, count)[index] = 300.0f * sin(heading);
+      lane(4, count)[index] = coordinate(random);
+      lane(5, count)[index] = coordinate(random);
+      lane(6, count)[index] = cos(turn);
+      lane(7, count)[index] = sin(turn);
+      lane(8, count)[index] = 60.0f;
+    }
+  }
+
+  float *lane(size_t which, size_t count) {
+    return floats.data() + which * count;
+  }
+
+  ProjectileLanes lanes(size_t count) {
+    return ProjectileLanes{lane(0, count), lane(1, count), lane(2, count),
+                           lane(3, count), lane(4, count), lane(5, count),
+                           lane(6, count), lane(7, count), lane(8, count),
+                           flags.data()};
+  }
+
+  vector<float> floats;
+  vector<uint8_t> flags;
+};
+
+// microseconds per tick, leaving the result in volley
+double time(Kernel kernel, Volley &volley, size_t count) {
+  ProjectileLanes lanes = volley.lanes(count);
+  steady_clock::time_point start = steady_clock::now();
+  for (size_t tick = 0; tick < TICKS; ++tick) kernel(lanes, 0, count, TICK);
+  return duration<double, micro>(steady_clock::now() - start).count() /
+         static_cast<double>(TICKS);
+}
+
+double timeSystem(size_t count) {
+  mt19937 random(static_cast<uint32_t>(count));
+  uniform_real_distribution<float> coordinate(0.0f, 100'000.0f);
+  World world;
+  vector<Entity> targets;
+  for (size_t index = 0; index < TARGETS; ++index) {
+    Entity target = world.create();
+    world.add(target, Position{coordinate(random), coordinate(random)});
+    world.add(target, Hull{1e9f, 1e9f});
+    targets.push_back(target);
+  }
+  for (size_t index = 0; index < count; ++index) {
+    Entity projectile = world.create();
+    world.add(projectile, Position{coordinate(random), coordinate(random)});
+    world.add(projectile, Velocity{300.0f, 0.0f});
+    world.add(projectile, Projectile{targets[index % TARGETS], 1.0f, 1e9f,
+                                     index % 4 == 0 ? 0.0f : 0.5f});
+  }
+
+  steady_clock::time_point start = steady_clock::now();
+  for (size_t tick = 0; tick < TICKS; ++tick) updateProjectiles(world, TICK);
+  return duration<double, micro>(steady_clock::now() - start).count() /
+         static_cast<double>(TICKS);
+}
+
+void run(size_t count) {
+  Volley scalar(count);
+  double scalarTime = time(advanceProjectilesScalar, scalar, count);
+  printf("%8zu %10.1f", count, scalarTime);
+#if defined(__x86_64__) || defined(__i386__)
+  struct {
+    bool supported;
+    Kernel kernel;
+  } const versions[] = {
+      {__builtin_cpu_supports("sse4.1") != 0, advanceProjectilesSse41},
+      {__builtin_cpu_supports("avx2") != 0, advanceProjectilesAvx2}};
+  for (auto const &version : versions) {
+    if (!version.supported) {
+      printf(" %10s", "-");
+      continue;
+    }
+    Volley simd(count);
+    double simdTime = time(version.kernel, simd, count);
+    bool same =
+        memcmp(scalar.floats.data(), simd.floats.data(),
+               scalar.floats.size() * sizeof(float)) == 0 &&
+        memcmp(scalar.flags.data(), simd.flags.data(), count) == 0;
+    printf(" %9.1f%s", simdTime, same ? " " : "!");
+  }
+#endif
+  printf(" %10.1f\n", timeSystem(count));
+}
+}  // namespace
+
+int main() {
+  jobs = make_unique<JobSystem>();
+  printf("microseconds per tick; ! marks a result differing from scalar\n");
+  printf("%8s %10s %10s %10s %10s\n", "count", "scalar", "sse4.1", "avx2",
+         "system");
+  for (size_t count = 10'000; count <= 160'000; count *= 2) run(count);
+  return 0;
+}
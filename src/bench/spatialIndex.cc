@@ -0,0 +1,127 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// spatial index benchmark - per-query cost against unit count, next to a
+// brute-force scan for comparison
+// units are spread over the whole campaign map, so density grows with count
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "game/spatialIndex.h"
+#include "game/world.h"
+#include "util/jobSystem.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace carrier_conquest::game;
+using namespace carrier_conquest::util;
+
+namespace {
+constexpr float MAP_SIZE = 1'000'000.0f;  // metres, as in GameState
+constexpr float WEAPON_RANGE = 20'000.0f;
+constexpr size_t NEAREST = 8;
+constexpr size_t QUERIES = 10'000;
+
+template <typename F>
+double microsecondsPer(size_t count, F const &f) {
+  steady_clock::time_point start = steady_clock::now();
+  for (size_t index = 0; index < count; ++index) f(index);
+  return duration<double, micro>(steady_clock::now() - start).count() /
+         static_cast<double>(count);
+}
+
+void run(size_t units) {
+  mt19937 random(units);
+  uniform_real_distribution<float> coordinate(0.0f, MAP_SIZE);
+  uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+
+  World world;
+  vector<Position> positions;
+  for (size_t index = 0; index < units; ++index) {
+    Entity entity = world.create();
+    Position position{coordinate(random), coordinate(random)};
+    world.add(entity, position);
+    world.add(entity, Allegiance{index % 2 == 0 ? Side::PLAYER : Side::ENEMY});
+    positions.push_back(position);
+  }
+
+  vector<SpatialIndex::RangeQuery> queries;
+  for (size_t index = 0; index < QUERIES; ++index)
+    queries.push_back(SpatialIndex::RangeQuery{
+        coordinate(random), coordinate(random), WEAPON_RANGE, Side::ENEMY});
+
+  SpatialIndex index;
+  steady_clock::time_point start = steady_clock::now();
+  index.rebuild(world);
+  double rebuild =
+      duration<double, milli>(steady_clock::now() - start).count();
+
+  vector<Entity> found;
+  double range = microsecondsPer(QUERIES, [&](size_t query) {
+    found.clear();
+    index.inRange(queries[query].x, queries[query].y, WEAPON_RANGE,
+                  Side::ENEMY, found);
+  });
+
+  vector<vector<Entity>> results(QUERIES);
+  start = steady_clock::now();
+  index.inRange(queries, results);
+  double batched =
+      duration<double, micro>(steady_clock::now() - start).count() /
+      static_cast<double>(QUERIES);
+
+  vector<SpatialIndex::Hit> nearest;
+  double knn = microsecondsPer(QUERIES, [&](size_t query) {
+    index.nearest(queries[query].x, queries[query].y, NEAREST, nullopt,
+                  nearest);
+  });
+
+  double ray = microsecondsPer(QUERIES, [&](size_t query) {
+    float direction = angle(random);
+    index.raycast(queries[query].x, queries[query].y, cos(direction),
+                  sin(direction), WEAPON_RANGE * 5.0f, 500.0f, Side::ENEMY);
+  });
+
+  double brute = microsecondsPer(QUERIES / 10, [&](size_t query) {
+    found.clear();
+    float rangeSquared = WEAPON_RANGE * WEAPON_RANGE;
+    for (size_t unit = 0; unit < units; ++unit) {
+      float dx = positions[unit].x - queries[query].x;
+      float dy = positions[unit].y - queries[query].y;
+      if (unit % 2 == 1 && dx * dx + dy * dy <= rangeSquared)
+        found.push_back(Entity{static_cast<uint32_t>(unit), 0});
+    }
+  });
+
+  printf("%8zu %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f\n", units, rebuild,
+         range, batched, knn, ray, brute);
+}
+}  // namespace
+
+int main() {
+  jobs = make_unique<JobSystem>();
+  printf("%8s %10s %10s %10s %10s %10s %10s\n", "units", "rebuild ms",
+         "range us", "batch us", "knn us", "ray us", "brute us");
+  for (size_t units = 1'000; units <= 256'000; units *= 2) run(units);
+  return 0;
+}
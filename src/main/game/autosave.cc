@@ -0,0 +1,78 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "game/autosave.h"
+
+#include <iostream>
+#include <system_error>
+
+using namespace std;
+using namespace std::filesystem;
+using namespace carrier_conquest::util;
+
+namespace carrier_conquest::game {
+Autosave::Autosave(path filename_) noexcept
+    : filename(move(filename_)),
+      image(),
+      pending(),
+      mutex(),
+      failureCount(0),
+      failure() {}
+
+Autosave::~Autosave() noexcept { wait(); }
+
+path const &Autosave::getFilename() const noexcept { return filename; }
+
+bool Autosave::isIdle() const noexcept {
+  return pending == nullptr || pending->isDone();
+}
+
+bool Autosave::save(World const &world, SaveInfo const &info) noexcept {
+  if (!isIdle()) return false;
+  captureSave(world, info, image);
+  // on a worker, so the owner's own waits never end up writing it
+  pending = jobs->submit(
+      [this](stop_token const &) {
+        try {
+          writeSave(filename, image);
+        } catch (system_error const &e) {
+          cerr << "ERROR: Could not save game: " << e.what() << endl;
+          lock_guard lock(mutex);
+          ++failureCount;
+          failure = e.what();
+        }
+      },
+      {}, JobSystem::Affinity::WORKERS);
+  return true;
+}
+
+void Autosave::wait() noexcept {
+  if (pending != nullptr) jobs->wait(pending);
+}
+
+uint32_t Autosave::getFailureCount() const noexcept {
+  lock_guard lock(mutex);
+  return failureCount;
+}
+
+optional<string> Autosave::getFailure() const noexcept {
+  lock_guard lock(mutex);
+  return failure;
+}
+}  // namespace carrier_conquest::game
@@ -0,0 +1,74 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_GAME_AUTOSAVE_H_
+#define CARRIERCONQUEST_GAME_AUTOSAVE_H_
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "game/saveFile.h"
+#include "game/world.h"
+#include "util/jobSystem.h"
+
+namespace carrier_conquest::game {
+// saves a game in the background - the world is copied out by whichever
+// thread owns it, then compressed and written by the job system, one save at a
+// time
+// saves that can't be written are counted, for the player to be told
+class Autosave final {
+ public:
+  explicit Autosave(std::filesystem::path filename) noexcept;
+  Autosave(Autosave const &) noexcept = delete;
+  Autosave(Autosave &&) noexcept = delete;
+
+  // waits for any save in progress
+  ~Autosave() noexcept;
+
+  Autosave &operator=(Autosave const &) noexcept = delete;
+  Autosave &operator=(Autosave &&) noexcept = delete;
+
+  std::filesystem::path const &getFilename() const noexcept;
+  // true if the last save has been written, and another may be started
+  bool isIdle() const noexcept;
+  // copies world and starts writing it, unless the last save is still being
+  // written; returns true if started
+  bool save(World const &world, SaveInfo const &info) noexcept;
+  // waits for the last save to be written
+  void wait() noexcept;
+  // how many saves couldn't be written, and why the latest one couldn't
+  uint32_t getFailureCount() const noexcept;
+  std::optional<std::string> getFailure() const noexcept;
+
+ private:
+  std::filesystem::path filename;
+  // only touched by the save job while it's running
+  SaveImage image;
+  util::JobSystem::Handle pending;
+
+  mutable std::mutex mutex;  // guards the failures, set by the save job
+  uint32_t failureCount;
+  std::optional<std::string> failure;
+};
+}  // namespace carrier_conquest::game
+
+#endif  // CARRIERCONQUEST_GAME_AUTOSAVE_H_
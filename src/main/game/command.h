@@ -0,0 +1,53 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_GAME_COMMAND_H_
+#define CARRIERCONQUEST_GAME_COMMAND_H_
+
+#include <cstdint>
+#include <type_traits>
+
+#include "game/entity.h"
+#include "game/world.h"
+
+namespace carrier_conquest::game {
+enum class CommandType : uint32_t {
+  SELECT,  // selects entity, or nothing, given Entity::NONE
+};
+
+// an order, from the player or the AI - everything that changes the world
+// other than the simulation itself goes through one, so a game can be
+// replayed from its commands
+// saved as is in replays, so fixed size, with no implicit padding
+struct Command final {
+  uint64_t tick;  // applied once this many ticks have passed
+  Entity entity;
+  float x;  // metres - the target of orders that take one
+  float y;
+  CommandType type;
+  uint32_t reserved;  // zero
+};
+
+static_assert(sizeof(Command) == 32 && std::is_trivially_copyable_v<Command>,
+              "commands are saved in their in-memory layout");
+
+void apply(World &world, Command const &command) noexcept;
+}  // namespace carrier_conquest::game
+
+#endif  // CARRIERCONQUEST_GAME_COMMAND_H_
@@ -0,0 +1,125 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_GAME_COMPONENTSTORE_H_
+#define CARRIERCONQUEST_GAME_COMPONENTSTORE_H_
+
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "game/entity.h"
+
+namespace carrier_conquest::game {
+// sparse set - components of one type are packed into a dense array in no
+// particular order, with a sparse index from entity to position in it
+// adding appends, removing swaps the last component into the hole
+template <typename T>
+class ComponentStore final {
+ public:
+  ComponentStore() noexcept : sparse(), entities(), components() {}
+  ComponentStore(ComponentStore const &) noexcept = delete;
+  ComponentStore(ComponentStore &&) noexcept = default;
+
+  ~ComponentStore() noexcept = default;
+
+  ComponentStore &operator=(ComponentStore const &) noexcept = delete;
+  ComponentStore &operator=(ComponentStore &&) noexcept = default;
+
+  T &add(Entity entity, T component) {
+    assert(!has(entity) && "entity already has this component");
+    if (entity.index >= sparse.size()) sparse.resize(entity.index + 1, NONE);
+    sparse[entity.index] = static_cast<uint32_t>(components.size());
+    entities.push_back(entity);
+    return components.emplace_back(std::move(component));
+  }
+
+  void remove(Entity entity) noexcept {
+    assert(has(entity) && "entity doesn't have this component");
+    uint32_t hole = sparse[entity.index];
+    uint32_t last = static_cast<uint32_t>(components.size() - 1);
+    if (hole != last) {
+      components[hole] = std::move(components[last]);
+      entities[hole] = entities[last];
+      sparse[entities[hole].index] = hole;
+    }
+    components.pop_back();
+    entities.pop_back();
+    sparse[entity.index] = NONE;
+  }
+
+  void clear() noexcept {
+    for (Entity entity : entities) sparse[entity.index] = NONE;
+    entities.clear();
+    components.clear();
+  }
+
+  // replaces the contents wholesale, as when loading - the entities must be
+  // distinct, and components is ignored for tags
+  void assign(std::span<Entity const> entities_,
+              std::span<T const> components_) {
+    entities.assign(entities_.begin(), entities_.end());
+    if constexpr (std::is_empty_v<T>) {
+      components.assign(entities.size(), T{});
+    } else {
+      assert(entities_.size() == components_.size() &&
+             "every entity needs a component");
+      components.assign(components_.begin(), components_.end());
+    }
+    sparse.clear();
+    for (uint32_t index = 0; index < entities.size(); ++index) {
+      if (entities[index].index >= sparse.size())
+        sparse.resize(entities[index].index + 1, NONE);
+      sparse[entities[index].index] = index;
+    }
+  }
+
+  bool has(Entity entity) const noexcept {
+    return entity.index < sparse.size() && sparse[entity.index] != NONE &&
+           entities[sparse[entity.index]] == entity;
+  }
+
+  T *get(Entity entity) noexcept {
+    return has(entity) ? &components[sparse[entity.index]] : nullptr;
+  }
+  T const *get(Entity entity) const noexcept {
+    return has(entity) ? &components[sparse[entity.index]] : nullptr;
+  }
+
+  // the dense arrays, for systems that walk every component in order;
+  // getEntities()[i] owns getComponents()[i]
+  std::span<T> getComponents() noexcept { return components; }
+  std::span<T const> getComponents() const noexcept { return components; }
+  std::span<Entity const> getEntities() const noexcept { return entities; }
+
+  size_t size() const noexcept { return components.size(); }
+
+ private:
+  std::vector<uint32_t> sparse;
+  std::vector<Entity> entities;
+  std::vector<T> components;
+
+  static constexpr uint32_t NONE = UINT32_MAX;
+};
+}  // namespace carrier_conquest::game
+
+#endif  // CARRIERCONQUEST_GAME_COMPONENTSTORE_H_
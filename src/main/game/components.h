@@ -0,0 +1,105 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_GAME_COMPONENTS_H_
+#define CARRIERCONQUEST_GAME_COMPONENTS_H_
+
+#include <cstdint>
+
+#include "game/entity.h"
+
+// plain data only - behaviour lives in the systems that iterate these
+namespace carrier_conquest::game {
+enum class Side : uint8_t {
+  PLAYER,
+  ENEMY,
+};
+
+// metres, in campaign-map space
+struct Position final {
+  float x;
+  float y;
+};
+
+// where Position was as of the previous tick, for drawing between ticks
+struct PreviousPosition final {
+  float x;
+  float y;
+};
+
+// metres per second
+struct Velocity final {
+  float x;
+  float y;
+};
+
+struct Allegiance final {
+  Side side;
+};
+
+struct Hull final {
+  float integrity;
+  float maxIntegrity;
+};
+
+struct Ship final {
+  Entity fleet;  // Entity::NONE if unattached
+};
+
+struct Carrier final {
+  uint32_t hangarCapacity;
+  uint32_t aircraft;  // aircraft aboard, not counting launched squadrons
+};
+
+struct Squadron final {
+  Entity carrier;
+  uint32_t aircraft;
+  float fuel;  // seconds of flight remaining
+};
+
+struct Projectile final {
+  Entity target;
+  float damage;
+  float lifetime;  // seconds
+  float turnRate;  // radians per second, zero if unguided
+};
+
+struct Fleet final {
+  Entity flagship;
+  uint32_t ships;
+};
+
+// the map is a square grid of sectors, each holding a few star systems
+struct Sector final {
+  uint32_t column;
+  uint32_t row;
+};
+
+struct StarSystem final {
+  Entity sector;
+  float industry;   // ship production, relative
+  float resources;  // stockpile, relative
+};
+
+// tags
+struct Spotted final {};   // the player has contact
+struct Selected final {};  // the player has it selected
+}  // namespace carrier_conquest::game
+
+#endif  // CARRIERCONQUEST_GAME_COMPONENTS_H_
@@ -0,0 +1,95 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "game/detMath.h"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+using namespace std;
+
+namespace carrier_conquest::game {
+namespace {
+constexpr double PI = 3.141592653589793238462643383279502884;
+constexpr uint32_t TABLE_BITS = 12;
+constexpr size_t TABLE_SIZE = size_t{1} << TABLE_BITS;  // entries per turn
+constexpr uint32_t FRACTION_BITS = 32 - TABLE_BITS;
+
+// sin x and cos x for x in [0, pi / 4], to double precision - evaluated by
+// the compiler, which rounds every operation correctly, so every build gets
+// the same table
+constexpr double taylor(double x, double term) noexcept {
+  // term is x for sin, or 1 for cos
+  double sum = term;
+  int power = term == 1.0 ? 0 : 1;
+  for (int n = 0; n < 12; ++n, power += 2) {
+    term *= -x * x / ((power + 1) * (power + 2));
+    sum += term;
+  }
+  return sum;
+}
+
+constexpr array<float, TABLE_SIZE> makeSines() noexcept {
+  constexpr size_t QUARTER = TABLE_SIZE / 4;
+  array<float, TABLE_SIZE> sines{};
+  for (size_t index = 0; index <= QUARTER; ++index) {
+    // past pi / 4, sin x is cos (pi / 2 - x), which converges as fast
+    bool low = index <= QUARTER / 2;
+    double x = 2.0 * PI * static_cast<double>(low ? index : QUARTER - index) /
+               static_cast<double>(TABLE_SIZE);
+    float sine = static_cast<float>(low ? taylor(x, x) : taylor(x, 1.0));
+    sines[index] = sine;
+    sines[TABLE_SIZE / 2 - index] = sine;
+    sines[(TABLE_SIZE / 2 + index) % TABLE_SIZE] = -sine;
+    sines[(TABLE_SIZE - index) % TABLE_SIZE] = -sine;
+  }
+  return sines;
+}
+
+constexpr array<float, TABLE_SIZE> SINES = makeSines();
+// radians per angle unit
+constexpr float STEP = static_cast<float>(2.0 * PI / 4294967296.0);
+}  // namespace
+
+Angle toAngle(float radians) noexcept {
+  // a double holds a float's angle in turns closely enough to round once, at
+  // the end - where a turn rounds up to 2^32, it wraps to zero
+  double turns = static_cast<double>(radians) * (1.0 / (2.0 * PI));
+  double fraction = turns - floor(turns);
+  return static_cast<Angle>(
+      static_cast<uint64_t>(fraction * 4294967296.0 + 0.5));
+}
+
+SinCos sinCos(Angle angle) noexcept {
+  // split into a table entry, and a remainder of less than one entry
+  uint32_t index = angle >> FRACTION_BITS;
+  float d = static_cast<float>(angle & ((Angle{1} << FRACTION_BITS) - 1)) *
+            STEP;
+  float sine = SINES[index];
+  float cosine = SINES[(index + TABLE_SIZE / 4) % TABLE_SIZE];
+
+  // angle-sum identities, with sin d and cos d from their series - d is under
+  // 2pi / TABLE_SIZE, so their next terms are below float's precision
+  float dd = d * d;
+  float sinD = d - d * dd * (1.0f / 6.0f);
+  float cosD = 1.0f - dd * 0.5f;
+  return SinCos{sine * cosD + cosine * sinD, cosine * cosD - sine * sinD};
+}
+}  // namespace carrier_conquest::game
@@ -0,0 +1,61 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_GAME_DETMATH_H_
+#define CARRIERCONQUEST_GAME_DETMATH_H_
+
+#include <cfloat>
+#include <cstdint>
+
+// deterministic maths for the simulation, giving the same results, bit for
+// bit, whatever the compiler or processor - replays and lockstep depend on it
+// binary32 +, -, *, / and sqrt are correctly rounded, so they're already
+// deterministic as long as every operation is rounded to float on its own:
+// no excess precision, and no contraction into FMAs (hence -ffp-contract=off)
+// libm's transcendentals aren't correctly rounded, and differ between
+// libraries and versions, so the simulation uses these instead
+static_assert(FLT_EVAL_METHOD == 0,
+              "the simulation needs float maths done in float - use SSE2");
+
+namespace carrier_conquest::game {
+// a binary angle - a whole turn is 2^32, so angles wrap exactly
+using Angle = uint32_t;
+
+constexpr Angle QUARTER_TURN = Angle{1} << 30;
+
+// the nearest angle to radians, wrapped into a turn
+Angle toAngle(float radians) noexcept;
+
+struct SinCos final {
+  float sin;
+  float cos;
+};
+
+// a table lookup, corrected with a short series - within a few ulp of the
+// exact value
+SinCos sinCos(Angle angle) noexcept;
+
+// unlike hypot, deterministic - each operation is rounded separately, so it's
+// not correctly rounded, and may overflow past about 1e19
+inline float length(float x, float y) noexcept {
+  return __builtin_sqrtf(x * x + y * y);
+}
+}  // namespace carrier_conquest::game
+
+#endif  // CARRIERCONQUEST_GAME_DETMATH_H_
@@ -0,0 +1,72 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "game/entity.h"
+
+#include <cassert>
+
+using namespace std;
+
+namespace carrier_conquest::game {
+EntityAllocator::EntityAllocator() noexcept : generations(), freeIndices() {}
+
+Entity EntityAllocator::create() {
+  if (freeIndices.empty()) {
+    generations.push_back(0);
+    return Entity{static_cast<uint32_t>(generations.size() - 1), 0};
+  } else {
+    uint32_t index = freeIndices.back();
+    freeIndices.pop_back();
+    return Entity{index, generations[index]};
+  }
+}
+
+void EntityAllocator::destroy(Entity entity) noexcept {
+  assert(alive(entity) && "entity has already been destroyed");
+  ++generations[entity.index];
+  freeIndices.push_back(entity.index);
+}
+
+bool EntityAllocator::alive(Entity entity) const noexcept {
+  return entity.index < generations.size() &&
+         generations[entity.index] == entity.generation;
+}
+
+uint32_t EntityAllocator::capacity() const noexcept {
+  return static_cast<uint32_t>(generations.size());
+}
+
+uint32_t EntityAllocator::size() const noexcept {
+  return static_cast<uint32_t>(generations.size() - freeIndices.size());
+}
+
+span<uint32_t const> EntityAllocator::getGenerations() const noexcept {
+  return generations;
+}
+
+span<uint32_t const> EntityAllocator::getFreeIndices() const noexcept {
+  return freeIndices;
+}
+
+void EntityAllocator::restore(span<uint32_t const> generations_,
+                              span<uint32_t const> freeIndices_) {
+  generations.assign(generations_.begin(), generations_.end());
+  freeIndices.assign(freeIndices_.begin(), freeIndices_.end());
+}
+}  // namespace carrier_conquest::game
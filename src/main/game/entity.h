@@ -0,0 +1,72 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_GAME_ENTITY_H_
+#define CARRIERCONQUEST_GAME_ENTITY_H_
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace carrier_conquest::game {
+// a stable handle - the generation changes whenever the index is reused, so
+// handles to destroyed entities never alias new ones
+struct Entity final {
+  uint32_t index;
+  uint32_t generation;
+
+  bool operator==(Entity const &) const noexcept = default;
+
+  static Entity const NONE;
+};
+
+inline constexpr Entity Entity::NONE = {UINT32_MAX, UINT32_MAX};
+
+class EntityAllocator final {
+ public:
+  EntityAllocator() noexcept;
+  EntityAllocator(EntityAllocator const &) noexcept = delete;
+  EntityAllocator(EntityAllocator &&) noexcept = default;
+
+  ~EntityAllocator() noexcept = default;
+
+  EntityAllocator &operator=(EntityAllocator const &) noexcept = delete;
+  EntityAllocator &operator=(EntityAllocator &&) noexcept = default;
+
+  Entity create();
+  void destroy(Entity entity) noexcept;
+  bool alive(Entity entity) const noexcept;
+
+  // one past the largest index ever handed out
+  uint32_t capacity() const noexcept;
+  uint32_t size() const noexcept;
+
+  // for saving and loading
+  std::span<uint32_t const> getGenerations() const noexcept;
+  std::span<uint32_t const> getFreeIndices() const noexcept;
+  void restore(std::span<uint32_t const> generations,
+               std::span<uint32_t const> freeIndices);
+
+ private:
+  std::vector<uint32_t> generations;
+  std::vector<uint32_t> freeIndices;
+};
+}  // namespace carrier_conquest::game
+
+#endif  // CARRIERCONQUEST_GAME_ENTITY_H_
@@ -19,61 +19,143 @@
 
 #include "game/game.h"
 
-#include <fstream>
-#include <nlohmann/json.hpp>
+#include <iomanip>
+#include <sstream>
 
+#include "game/generation.h"
+#include "game/kinematics.h"
+#include "game/projectiles.h"
+#include "game/saveFile.h"
+#include "game/saveJson.h"
+#include "util/arena.h"
 #include "util/paths.h"
 
 using namespace std;
 using namespace std::filesystem;
 using namespace carrier_conquest::util;
 using namespace carrier_conquest::util::exceptions;
-using namespace nlohmann;
 
 namespace carrier_conquest::game {
-void GameState::generate(std::stop_token const &token,
-                         uint32_t difficulty) noexcept {
-  // TODO
+namespace {
+// each new campaign gets its own save slot, named for its seed
+path slotFor(uint64_t seed) noexcept {
+  stringstream ss;
+  ss << "campaign-" << hex << setw(16) << setfill('0') << seed
+     << SAVE_EXTENSION;
+  return getSavePath() / ss.str();
 }
-void GameState::load(std::stop_token const &token) noexcept {
+
+path replayFor(path filename) noexcept {
+  return filename.replace_extension(REPLAY_EXTENSION);
+}
+}  // namespace
+
+void GameState::generate(std::stop_token const &token, uint32_t difficulty,
+                         uint64_t seed, Progress &progress) noexcept {
+  World world;
+  if (!generateCampaign(world, seed, difficulty, token, progress)) return;
+  gameState = unique_ptr<GameState>(
+      new GameState(move(world), seed, difficulty));
+}
+void GameState::load(std::stop_token const &token,
+                     path const &filename) noexcept {
+  // let the current game finish saving before reading its save back
+  gameState = unique_ptr<GameState>();
   try {
-    gameState = unique_ptr<GameState>(new GameState);
+    gameState = unique_ptr<GameState>(new GameState(filename));
   } catch (LoadException const &e) {
     gameState = e;
   }
 }
 
-void to_json(json &j, GameState const &s) {}
+void step(World &world, SpatialIndex &spatialIndex) noexcept {
+  // whatever the tick leaves in this thread's scratch arena is freed with it
+  Arena::Scope scope(threadArena());
+  integrate(world, GameState::TICK_LENGTH);
+  updateProjectiles(world, GameState::TICK_LENGTH);
+  spatialIndex.rebuild(world);
+}
 
-void from_json(json const &j, GameState &s) {}
+void GameState::tick() noexcept {
+  step(world, spatialIndex);
+  ++ticks;
+  if (ticks % ReplayRecorder::KEYFRAME_INTERVAL == 0)
+    replay.keyframe(world, getInfo());
+  if (ticks % AUTOSAVE_INTERVAL == 0 && autosave.save(world, getInfo()))
+    replay.save(replayFor(autosave.getFilename()), ticks);
+}
 
-GameState::GameState() {
-  path savePath = getSavePath() / "save.json";
+void GameState::issue(Command const &command) noexcept {
+  apply(world, command);
+  replay.record(command);
+}
 
-  try {
-    ifstream fin;
-    fin.exceptions(ifstream::failbit | ifstream::badbit);
-    fin.open(savePath, ios_base::in | ios_base::binary);
-
-    json j;
-    j.get_to(*this);
-  } catch (ios_base::failure const &e) {
-    throw LoadException("Could not read save file", e.what());
-  } catch (json::exception const &e) {
-    throw LoadException("Could not read save file", e.what());
-  }
+void GameState::save() noexcept {
+  autosave.wait();
+  autosave.save(world, getInfo());
+  replay.save(replayFor(autosave.getFilename()), ticks);
+}
+
+string const &GameState::getName() const noexcept { return name; }
+
+uint64_t GameState::getTicks() const noexcept { return ticks; }
+
+uint64_t GameState::getSeed() const noexcept { return seed; }
+
+uint32_t GameState::getDifficulty() const noexcept { return difficulty; }
+
+Autosave const &GameState::getAutosave() const noexcept { return autosave; }
+
+GameState::GameState(path const &filename)
+    : world(),
+      spatialIndex(),
+      name(),
+      ticks(0),
+      seed(0),
+      difficulty(0),
+      autosave(filename),
+      replay() {
+  SaveFile save(filename);
+  SaveInfo info = save.getInfo();
+  name = info.name;
+  ticks = info.ticks;
+  seed = info.seed;
+  difficulty = info.difficulty;
+  save.read(world);
+  spatialIndex.rebuild(world);
+  replay.keyframe(world, getInfo());
+}
+
+GameState::GameState(World world_, uint64_t seed_,
+                     uint32_t difficulty_) noexcept
+    : world(move(world_)),
+      spatialIndex(),
+      name(),
+      ticks(0),
+      seed(seed_),
+      difficulty(difficulty_),
+      autosave(slotFor(seed_)),
+      replay() {
+  stringstream ss;
+  ss << "Campaign " << hex << uppercase << setw(4) << setfill('0')
+     << (seed & 0xffff);
+  name = ss.str();
+  spatialIndex.rebuild(world);
+  replay.keyframe(world, getInfo());
 }
 
 GameState::~GameState() noexcept {
+#ifndef NDEBUG
   try {
-    ofstream fout;
-    fout.exceptions(ofstream::failbit | ofstream::badbit);
-    fout.open(getSavePath() / "save.json", ios_base::out | ios_base::binary);
-    json j(*this);
-    fout << setw(2) << j;
+    exportJson(getSavePath() / "save.json", world, getInfo());
   } catch (...) {
-    // swallow exceptions - this is a destructor
+    // the export is only a debugging aid
   }
+#endif
+}
+
+SaveInfo GameState::getInfo() const noexcept {
+  return SaveInfo{name, ticks, seed, difficulty};
 }
 
 std::variant<std::unique_ptr<GameState>, util::exceptions::LoadException>
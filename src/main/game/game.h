@@ -21,18 +21,35 @@
 #define CARRIERCONQUEST_GAME_GAME_H_
 
 #include <cstdint>
+#include <filesystem>
 #include <memory>
+#include <string>
 #include <thread>
 #include <variant>
 
+#include "game/autosave.h"
+#include "game/command.h"
+#include "game/replay.h"
+#include "game/spatialIndex.h"
+#include "game/world.h"
 #include "util/exceptions/loadException.h"
+#include "util/progress.h"
 
 namespace carrier_conquest::game {
+// advances a world by one tick, running every system in order, then rebuilds
+// its spatial index - all there is to a tick, short of saving
+void step(World &world, SpatialIndex &spatialIndex) noexcept;
+
 class GameState final {
  public:
-  static void generate(std::stop_token const &token,
-                       uint32_t difficulty) noexcept;
-  static void load(std::stop_token const &token) noexcept;
+  // replaces gameState with a new campaign, in a save slot of its own, unless
+  // stopped first
+  static void generate(std::stop_token const &token, uint32_t difficulty,
+                       uint64_t seed, util::Progress &progress) noexcept;
+  // replaces gameState with the campaign saved in filename, or the reason it
+  // couldn't be loaded
+  static void load(std::stop_token const &token,
+                   std::filesystem::path const &filename) noexcept;
 
   GameState(GameState const &) noexcept = delete;
   GameState(GameState &&) noexcept = delete;
@@ -42,8 +59,41 @@ class GameState final {
   GameState &operator=(GameState const &) noexcept = delete;
   GameState &operator=(GameState &&) noexcept = delete;
 
+  // advances the simulation by TICK_LENGTH, starting an autosave every
+  // AUTOSAVE_INTERVAL ticks
+  void tick() noexcept;
+  // applies a command, and records it in the replay
+  void issue(Command const &command) noexcept;
+  // starts saving the game and its replay in the background, once any save
+  // in progress is written - call from the thread that owns the game state
+  void save() noexcept;
+  std::string const &getName() const noexcept;
+  uint64_t getTicks() const noexcept;
+  uint64_t getSeed() const noexcept;
+  uint32_t getDifficulty() const noexcept;
+  Autosave const &getAutosave() const noexcept;
+
+  World world;
+  // rebuilt at the end of every tick
+  SpatialIndex spatialIndex;
+
+  static constexpr float TICK_LENGTH = 1.0f / 20.0f;  // seconds
+  static constexpr float MAP_SIZE = 1'000'000.0f;     // metres, square
+  static constexpr uint64_t AUTOSAVE_INTERVAL = 5 * 60 * 20;  // ticks
+
  private:
-  GameState();
+  std::string name;
+  uint64_t ticks;
+  uint64_t seed;
+  uint32_t difficulty;
+  Autosave autosave;
+  // of this session - next to the save, and replaced along with it
+  ReplayRecorder replay;
+
+  explicit GameState(std::filesystem::path const &filename);
+  GameState(World world, uint64_t seed, uint32_t difficulty) noexcept;
+
+  SaveInfo getInfo() const noexcept;
 };
 
 extern std::variant<std::unique_ptr<GameState>, util::exceptions::LoadException>
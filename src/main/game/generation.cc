@@ -0,0 +1,227 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "game/generation.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "game/game.h"
+#include "util/jobSystem.h"
+#include "util/random.h"
+
+using namespace std;
+using namespace carrier_conquest::util;
+
+namespace carrier_conquest::game {
+namespace {
+constexpr uint32_t SECTORS_PER_SIDE = 16;
+constexpr uint32_t SECTORS = SECTORS_PER_SIDE * SECTORS_PER_SIDE;
+constexpr float SECTOR_SIZE =
+    GameState::MAP_SIZE / static_cast<float>(SECTORS_PER_SIDE);
+constexpr float SECTOR_MARGIN = SECTOR_SIZE / 10.0f;
+constexpr uint32_t MIN_SYSTEMS = 3;  // per sector
+constexpr uint32_t MAX_SYSTEMS = 8;
+// the player holds the sectors this close to the corner, by taxicab distance
+constexpr uint32_t HOME_SECTORS = 2;
+
+constexpr uint32_t PLAYER_SHIPS = 8;
+constexpr uint32_t ENEMY_SHIPS_PER_SECTOR = 6;  // at difficulty 100
+constexpr uint32_t SHIPS_PER_FLEET = 8;
+constexpr float FLEET_SPREAD = 2'000.0f;  // metres from its star system
+
+constexpr float CARRIER_HULL = 1'000.0f;
+constexpr float ESCORT_HULL = 400.0f;
+constexpr uint32_t HANGAR_CAPACITY = 40;
+
+// random streams - each sector draws from its own, derived from these
+enum Stream : uint64_t {
+  LAYOUT,
+  FLEETS,
+};
+
+struct SystemPlan final {
+  float x;
+  float y;
+  float industry;
+  float resources;
+};
+
+struct ShipPlan final {
+  float x;
+  float y;
+  bool carrier;
+};
+
+struct SectorPlan final {
+  Side side;
+  float industry;
+  vector<SystemPlan> systems;
+  vector<vector<ShipPlan>> fleets;
+};
+
+void planLayout(SectorPlan &sector, uint32_t index, uint64_t seed) noexcept {
+  Random random(Random::derive(Random::derive(seed, LAYOUT), index));
+  uint32_t column = index % SECTORS_PER_SIDE;
+  uint32_t row = index / SECTORS_PER_SIDE;
+  sector.side = column + row <= HOME_SECTORS ? Side::PLAYER : Side::ENEMY;
+
+  float left = static_cast<float>(column) * SECTOR_SIZE + SECTOR_MARGIN;
+  float top = static_cast<float>(row) * SECTOR_SIZE + SECTOR_MARGIN;
+  float extent = SECTOR_SIZE - 2.0f * SECTOR_MARGIN;
+  uint32_t systems = MIN_SYSTEMS + random.below(MAX_SYSTEMS - MIN_SYSTEMS + 1);
+  sector.industry = 0.0f;
+  for (uint32_t system = 0; system < systems; ++system) {
+    SystemPlan plan{random.uniform(left, left + extent),
+                    random.uniform(top, top + extent),
+                    random.uniform(0.5f, 2.0f), random.uniform(0.0f, 1.0f)};
+    sector.industry += plan.industry;
+    sector.systems.push_back(plan);
+  }
+}
+
+void planFleets(SectorPlan &sector, uint32_t index, uint32_t ships,
+                uint64_t seed) noexcept {
+  Random random(Random::derive(Random::derive(seed, FLEETS), index));
+  while (ships != 0) {
+    uint32_t count = min(ships, SHIPS_PER_FLEET);
+    ships -= count;
+    SystemPlan const &station =
+        sector.systems[random.below(static_cast<uint32_t>(
+            sector.systems.size()))];
+    vector<ShipPlan> &fleet = sector.fleets.emplace_back();
+    for (uint32_t ship = 0; ship < count; ++ship)
+      fleet.push_back(ShipPlan{
+          station.x + random.uniform(-FLEET_SPREAD, FLEET_SPREAD),
+          station.y + random.uniform(-FLEET_SPREAD, FLEET_SPREAD),
+          ship == 0});
+  }
+}
+
+// enemy ships scale with difficulty, and go to sectors by their share of
+// enemy industry - largest remainders get the leftovers
+vector<uint32_t> allocateShips(vector<SectorPlan> const &sectors,
+                               uint32_t difficulty) noexcept {
+  vector<uint32_t> ships(SECTORS, 0);
+  ships[0] = PLAYER_SHIPS;
+
+  uint32_t enemySectors = 0;
+  float enemyIndustry = 0.0f;
+  for (SectorPlan const &sector : sectors) {
+    if (sector.side != Side::ENEMY) continue;
+    ++enemySectors;
+    enemyIndustry += sector.industry;
+  }
+  if (enemySectors == 0) return ships;
+
+  uint32_t budget = enemySectors * ENEMY_SHIPS_PER_SECTOR * difficulty / 100;
+  vector<float> remainders(SECTORS, -1.0f);
+  uint32_t allocated = 0;
+  for (uint32_t index = 0; index < SECTORS; ++index) {
+    if (sectors[index].side != Side::ENEMY) continue;
+    float share = static_cast<float>(budget) * sectors[index].industry /
+                  enemyIndustry;
+    ships[index] = static_cast<uint32_t>(share);
+    remainders[index] = share - static_cast<float>(ships[index]);
+    allocated += ships[index];
+  }
+
+  vector<uint32_t> order(SECTORS);
+  iota(order.begin(), order.end(), 0);
+  stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    return remainders[a] > remainders[b];
+  });
+  for (uint32_t index = 0; allocated < budget; ++index, ++allocated)
+    ++ships[order[index % SECTORS]];
+  return ships;
+}
+
+void spawnShip(World &world, ShipPlan const &plan, Side side,
+               Entity fleet) noexcept {
+  Entity ship = world.create();
+  world.add(ship, Position{plan.x, plan.y});
+  world.add(ship, PreviousPosition{plan.x, plan.y});
+  world.add(ship, Velocity{0.0f, 0.0f});
+  world.add(ship, Allegiance{side});
+  float hull = plan.carrier ? CARRIER_HULL : ESCORT_HULL;
+  world.add(ship, Hull{hull, hull});
+  world.add(ship, Ship{fleet});
+  if (plan.carrier) {
+    world.add(ship, Carrier{HANGAR_CAPACITY, HANGAR_CAPACITY});
+    world.get<Fleet>(fleet)->flagship = ship;
+  }
+}
+}  // namespace
+
+bool generateCampaign(World &world, uint64_t seed, uint32_t difficulty,
+                      stop_token const &token, Progress &progress) noexcept {
+  // one unit per sector laid out, one per sector's fleets planned, and one
+  // for building the world
+  progress.reset(2 * SECTORS + 1);
+
+  vector<SectorPlan> sectors(SECTORS);
+  jobs->parallelFor(SECTORS, 1, [&](size_t begin, size_t end) {
+    for (size_t index = begin; index < end; ++index) {
+      if (token.stop_requested()) return;
+      planLayout(sectors[index], static_cast<uint32_t>(index), seed);
+      progress.advance();
+    }
+  });
+  if (token.stop_requested()) return false;
+
+  vector<uint32_t> ships = allocateShips(sectors, difficulty);
+  jobs->parallelFor(SECTORS, 1, [&](size_t begin, size_t end) {
+    for (size_t index = begin; index < end; ++index) {
+      if (token.stop_requested()) return;
+      planFleets(sectors[index], static_cast<uint32_t>(index), ships[index],
+                 seed);
+      progress.advance();
+    }
+  });
+  if (token.stop_requested()) return false;
+
+  // built in sector order, so entity handles don't depend on scheduling
+  for (uint32_t index = 0; index < SECTORS; ++index) {
+    if (token.stop_requested()) return false;
+    SectorPlan const &plan = sectors[index];
+
+    Entity sector = world.create();
+    world.add(sector,
+              Sector{index % SECTORS_PER_SIDE, index / SECTORS_PER_SIDE});
+    world.add(sector, Allegiance{plan.side});
+    for (SystemPlan const &systemPlan : plan.systems) {
+      Entity system = world.create();
+      world.add(system, Position{systemPlan.x, systemPlan.y});
+      world.add(system, Allegiance{plan.side});
+      world.add(system, StarSystem{sector, systemPlan.industry,
+                                   systemPlan.resources});
+    }
+    for (vector<ShipPlan> const &fleetPlan : plan.fleets) {
+      Entity fleet = world.create();
+      world.add(fleet, Fleet{Entity::NONE,
+                             static_cast<uint32_t>(fleetPlan.size())});
+      for (ShipPlan const &shipPlan : fleetPlan)
+        spawnShip(world, shipPlan, plan.side, fleet);
+    }
+  }
+  progress.advance();
+  return true;
+}
+}  // namespace carrier_conquest::game
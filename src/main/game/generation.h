@@ -0,0 +1,38 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_GAME_GENERATION_H_
+#define CARRIERCONQUEST_GAME_GENERATION_H_
+
+#include <cstdint>
+#include <stop_token>
+
+#include "game/world.h"
+#include "util/progress.h"
+
+namespace carrier_conquest::game {
+// fills an empty world with a new campaign - the same seed and difficulty
+// always give the same campaign, however the work is spread over threads
+// returns false if stopped partway, leaving the world half-built
+bool generateCampaign(World &world, uint64_t seed, uint32_t difficulty,
+                      std::stop_token const &token,
+                      util::Progress &progress) noexcept;
+}  // namespace carrier_conquest::game
+
+#endif  // CARRIERCONQUEST_GAME_GENERATION_H_
@@ -0,0 +1,56 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "game/kinematics.h"
+
+#include "util/jobSystem.h"
+
+using namespace carrier_conquest::util;
+
+namespace carrier_conquest::game {
+namespace {
+// components per job - small enough to spread a fleet battle over every core
+constexpr size_t GRAIN = 4096;
+}  // namespace
+
+void integrate(World &world, float dt) noexcept {
+  ComponentStore<PreviousPosition> &previous = world.store<PreviousPosition>();
+  jobs->parallelFor(previous.size(), GRAIN, [&](size_t begin, size_t end) {
+    for (size_t index = begin; index < end; ++index) {
+      Position const *position =
+          world.get<Position>(previous.getEntities()[index]);
+      if (position == nullptr) continue;
+      previous.getComponents()[index].x = position->x;
+      previous.getComponents()[index].y = position->y;
+    }
+  });
+
+  ComponentStore<Velocity> &velocities = world.store<Velocity>();
+  jobs->parallelFor(velocities.size(), GRAIN, [&](size_t begin, size_t end) {
+    for (size_t index = begin; index < end; ++index) {
+      Entity entity = velocities.getEntities()[index];
+      Position *position = world.get<Position>(entity);
+      if (position == nullptr || world.has<Projectile>(entity)) continue;
+      Velocity const &velocity = velocities.getComponents()[index];
+      position->x += velocity.x * dt;
+      position->y += velocity.y * dt;
+    }
+  });
+}
+}  // namespace carrier_conquest::game
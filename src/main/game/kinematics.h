@@ -0,0 +1,32 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_GAME_KINEMATICS_H_
+#define CARRIERCONQUEST_GAME_KINEMATICS_H_
+
+#include "game/world.h"
+
+namespace carrier_conquest::game {
+// moves everything with a velocity by one step of dt seconds, remembering
+// where it was for interpolation - except projectiles, which
+// updateProjectiles moves
+void integrate(World &world, float dt) noexcept;
+}  // namespace carrier_conquest::game
+
+#endif  // CARRIERCONQUEST_GAME_KINEMATICS_H_
@@ -0,0 +1,678 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "game/navigation.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <utility>
+
+#include "game/game.h"
+#include "util/arena.h"
+#include "util/jobSystem.h"
+
+using namespace std;
+using namespace carrier_conquest::util;
+
+namespace carrier_conquest::game {
+namespace {
+constexpr int32_t GRID = static_cast<int32_t>(Navigation::GRID_SIZE);
+constexpr int32_t SIDE = static_cast<int32_t>(Navigation::CELLS_PER_SECTOR);
+constexpr size_t SECTOR_CELLS = SIDE * SIDE;
+constexpr float CELL_SIZE = GameState::MAP_SIZE / static_cast<float>(GRID);
+// costs are whole numbers, so comparing them is exact - ten per cell
+// straight across, fourteen diagonally
+constexpr uint32_t STRAIGHT = 10;
+constexpr uint32_t DIAGONAL = 14;
+constexpr uint32_t UNREACHABLE = UINT32_MAX;
+constexpr uint8_t NO_DIRECTION = 8;
+// a clear stretch of border at least this long gets an entrance at each end,
+// rather than one in the middle
+constexpr int32_t WIDE_ENTRANCE = 6;
+
+struct Move final {
+  int32_t dx;
+  int32_t dy;
+  uint32_t cost;
+  Navigation::Heading heading;
+};
+
+// anticlockwise from east, so the opposite of move d is move (d + 4) % 8
+constexpr float HALF_ROOT_TWO = 0.70710677f;
+constexpr array<Move, 8> MOVES = {{
+    {1, 0, STRAIGHT, {1.0f, 0.0f}},
+    {1, 1, DIAGONAL, {HALF_ROOT_TWO, HALF_ROOT_TWO}},
+    {0, 1, STRAIGHT, {0.0f, 1.0f}},
+    {-1, 1, DIAGONAL, {-HALF_ROOT_TWO, HALF_ROOT_TWO}},
+    {-1, 0, STRAIGHT, {-1.0f, 0.0f}},
+    {-1, -1, DIAGONAL, {-HALF_ROOT_TWO, -HALF_ROOT_TWO}},
+    {0, -1, STRAIGHT, {0.0f, -1.0f}},
+    {1, -1, DIAGONAL, {HALF_ROOT_TWO, -HALF_ROOT_TWO}},
+}};
+
+int32_t xOf(uint32_t cell) noexcept {
+  return static_cast<int32_t>(cell % Navigation::GRID_SIZE);
+}
+int32_t yOf(uint32_t cell) noexcept {
+  return static_cast<int32_t>(cell / Navigation::GRID_SIZE);
+}
+uint32_t cellOf(int32_t x, int32_t y) noexcept {
+  return static_cast<uint32_t>(y * GRID + x);
+}
+// index of a cell within its sector
+size_t localOf(uint32_t cell) noexcept {
+  return static_cast<size_t>(yOf(cell) % SIDE * SIDE + xOf(cell) % SIDE);
+}
+uint64_t keyOf(uint32_t from, uint32_t to) noexcept {
+  return uint64_t{from} << 32 | to;
+}
+
+float centreOf(int32_t coordinate) noexcept {
+  return (static_cast<float>(coordinate) + 0.5f) * CELL_SIZE;
+}
+
+// the cost of the shortest path between the cells, were nothing in the way
+uint32_t octile(uint32_t from, uint32_t to) noexcept {
+  uint32_t dx = static_cast<uint32_t>(abs(xOf(from) - xOf(to)));
+  uint32_t dy = static_cast<uint32_t>(abs(yOf(from) - yOf(to)));
+  return STRAIGHT * max(dx, dy) + (DIAGONAL - STRAIGHT) * min(dx, dy);
+}
+
+// calls f(x, y) for each cell the segment between the centres of two cells
+// passes through, stopping early if it returns false - where the segment
+// passes exactly through a corner, both cells beside it count
+template <typename F>
+bool traverse(uint32_t from, uint32_t to, F const &f) noexcept {
+  int32_t x = xOf(from);
+  int32_t y = yOf(from);
+  int32_t dx = abs(xOf(to) - x);
+  int32_t dy = abs(yOf(to) - y);
+  int32_t stepX = xOf(to) > x ? 1 : -1;
+  int32_t stepY = yOf(to) > y ? 1 : -1;
+  // which grid line the segment crosses next, scaled by 2 * dx * dy
+  int32_t error = dx - dy;
+  for (int32_t remaining = dx + dy;;) {
+    if (!f(x, y)) return false;
+    if (remaining == 0) return true;
+    if (error > 0) {
+      x += stepX;
+      error -= 2 * dy;
+      --remaining;
+    } else if (error < 0) {
+      y += stepY;
+      error += 2 * dx;
+      --remaining;
+    } else {
+      if (!f(x + stepX, y) || !f(x, y + stepY)) return false;
+      x += stepX;
+      y += stepY;
+      error += 2 * (dx - dy);
+      remaining -= 2;
+    }
+  }
+}
+
+// a min-heap of (cost, cell or node), kept in scratch memory
+using Frontier = ArenaVector<pair<uint32_t, uint32_t>>;
+
+void push(Frontier &frontier, uint32_t cost, uint32_t item) noexcept {
+  frontier.emplace_back(cost, item);
+  push_heap(frontier.begin(), frontier.end(), greater<>());
+}
+pair<uint32_t, uint32_t> pop(Frontier &frontier) noexcept {
+  pop_heap(frontier.begin(), frontier.end(), greater<>());
+  pair<uint32_t, uint32_t> top = frontier.back();
+  frontier.pop_back();
+  return top;
+}
+}  // namespace
+
+Navigation::FlowField::FlowField(uint32_t goal_, uint64_t version_) noexcept
+    : goal(goal_),
+      version(version_),
+      costs(GRID_SIZE * GRID_SIZE, UNREACHABLE),
+      directions(GRID_SIZE * GRID_SIZE, NO_DIRECTION) {}
+
+Navigation::Heading Navigation::FlowField::heading(float x,
+                                                   float y) const noexcept {
+  uint8_t direction = directions[cellAt(x, y)];
+  if (direction == NO_DIRECTION) return Heading{0.0f, 0.0f};
+  return MOVES[direction].heading;
+}
+
+float Navigation::FlowField::distance(float x, float y) const noexcept {
+  uint32_t cost = costs[cellAt(x, y)];
+  if (cost == UNREACHABLE) return numeric_limits<float>::infinity();
+  return static_cast<float>(cost) * (CELL_SIZE / static_cast<float>(STRAIGHT));
+}
+
+Navigation::Navigation() noexcept
+    : coverage(GRID_SIZE * GRID_SIZE, 0),
+      obstacles(),
+      dirty(),
+      version(0),
+      clusters(SECTORS),
+      nodeBases(SECTORS + 1, 0),
+      nodeCells(),
+      clock(0),
+      pathCache(),
+      fieldCache(),
+      nextTicket(0),
+      pendingPaths(),
+      pendingFields(),
+      answers() {
+  dirty.set();
+}
+
+void Navigation::setObstacle(Entity entity, float x, float y,
+                             float radius) noexcept {
+  if (entity.index >= obstacles.size())
+    obstacles.resize(entity.index + 1,
+                     Footprint{Entity::NONE, 0.0f, 0.0f, 0.0f, 0, 0, -1, -1});
+  Footprint &footprint = obstacles[entity.index];
+  // a destroyed entity's obstacle goes with it, even if never removed
+  if (footprint.entity != Entity::NONE) stamp(footprint, -1);
+
+  auto cellRange = [](float low, float high) {
+    float last = static_cast<float>(GRID - 1);
+    return pair{
+        static_cast<int32_t>(clamp(floor(low / CELL_SIZE), 0.0f, last)),
+        static_cast<int32_t>(clamp(floor(high / CELL_SIZE), 0.0f, last))};
+  };
+  auto [minX, maxX] = cellRange(x - radius, x + radius);
+  auto [minY, maxY] = cellRange(y - radius, y + radius);
+  footprint = Footprint{entity, x, y, radius, minX, minY, maxX, maxY};
+  stamp(footprint, 1);
+}
+
+void Navigation::removeObstacle(Entity entity) noexcept {
+  if (entity.index >= obstacles.size()) return;
+  Footprint &footprint = obstacles[entity.index];
+  if (footprint.entity != entity) return;
+  stamp(footprint, -1);
+  footprint.entity = Entity::NONE;
+}
+
+bool Navigation::passable(float x, float y) const noexcept {
+  return coverage[cellAt(x, y)] == 0;
+}
+
+Navigation::Ticket Navigation::requestPath(float fromX, float fromY, float toX,
+                                           float toY) noexcept {
+  Ticket ticket = nextTicket++;
+  uint32_t from = cellAt(fromX, fromY);
+  uint32_t to = cellAt(toX, toY);
+  // cached paths aren't checked against obstacle changes until the update
+  if (dirty.none()) {
+    auto found = pathCache.find(keyOf(from, to));
+    if (found != pathCache.end()) {
+      found->second.lastUsed = ++clock;
+      answers.emplace(ticket, answer(found->second, toX, toY));
+      return ticket;
+    }
+  }
+  pendingPaths.push_back(PathQuery{ticket, from, to, toX, toY});
+  return ticket;
+}
+
+optional<vector<Position>> Navigation::takePath(Ticket ticket) noexcept {
+  auto found = answers.find(ticket);
+  if (found == answers.end()) return nullopt;
+  vector<Position> path = move(found->second);
+  answers.erase(found);
+  return path;
+}
+
+shared_ptr<Navigation::FlowField const> Navigation::flowField(
+    float x, float y) noexcept {
+  uint32_t goal = cellAt(x, y);
+  CachedField &cached = fieldCache[goal];
+  cached.lastUsed = ++clock;
+  if (!cached.queued && (cached.field == nullptr ||
+                         cached.field->version != version || dirty.any())) {
+    cached.queued = true;
+    pendingFields.push_back(goal);
+  }
+  return cached.field;
+}
+
+void Navigation::update() noexcept {
+  if (dirty.any()) {
+    // a sector's entrances depend on the cells across its borders too
+    bitset<SECTORS> stale;
+    for (uint32_t sector = 0; sector < SECTORS; ++sector) {
+      if (!dirty[sector]) continue;
+      uint32_t column = sector % SECTORS_PER_SIDE;
+      uint32_t row = sector / SECTORS_PER_SIDE;
+      stale.set(sector);
+      if (column > 0) stale.set(sector - 1);
+      if (column + 1 < SECTORS_PER_SIDE) stale.set(sector + 1);
+      if (row > 0) stale.set(sector - SECTORS_PER_SIDE);
+      if (row + 1 < SECTORS_PER_SIDE) stale.set(sector + SECTORS_PER_SIDE);
+    }
+    vector<uint32_t> rebuilt;
+    for (uint32_t sector = 0; sector < SECTORS; ++sector)
+      if (stale[sector]) rebuilt.push_back(sector);
+    jobs->parallelFor(rebuilt.size(), 1, [&](size_t begin, size_t end) {
+      for (size_t index = begin; index < end; ++index)
+        rebuildCluster(rebuilt[index]);
+    });
+
+    nodeCells.clear();
+    for (uint32_t sector = 0; sector < SECTORS; ++sector) {
+      vector<uint32_t> const &nodes = clusters[sector].nodes;
+      nodeBases[sector + 1] =
+          nodeBases[sector] + static_cast<uint32_t>(nodes.size());
+      nodeCells.insert(nodeCells.end(), nodes.begin(), nodes.end());
+    }
+
+    // a path is only blocked by a cell on it closing, but a path might be
+    // found where there was none before anywhere something opened
+    erase_if(pathCache, [&](auto const &entry) {
+      return !entry.second.reachable || (entry.second.sectors & dirty).any();
+    });
+    ++version;
+    dirty.reset();
+  }
+
+  size_t paths = min(pendingPaths.size(), PATHS_PER_TICK);
+  size_t fields = min(pendingFields.size(), FIELDS_PER_TICK);
+  vector<CachedPath> found(paths);
+  vector<shared_ptr<FlowField const>> built(fields);
+  jobs->parallelFor(paths + fields, 1, [&](size_t begin, size_t end) {
+    for (size_t index = begin; index < end; ++index) {
+      if (index < paths) {
+        PathQuery const &query = pendingPaths[index];
+        CachedPath &path = found[index];
+        path.reachable =
+            findPath(query.from, query.to, path.waypoints, path.sectors);
+      } else {
+        built[index - paths] = buildField(pendingFields[index - paths]);
+      }
+    }
+  });
+
+  for (size_t index = 0; index < paths; ++index) {
+    PathQuery const &query = pendingPaths[index];
+    found[index].lastUsed = ++clock;
+    answers.emplace(query.ticket, answer(found[index], query.toX, query.toY));
+    pathCache.insert_or_assign(keyOf(query.from, query.to),
+                               move(found[index]));
+  }
+  pendingPaths.erase(pendingPaths.begin(),
+                     pendingPaths.begin() + static_cast<ptrdiff_t>(paths));
+  for (size_t index = 0; index < fields; ++index) {
+    CachedField &cached = fieldCache[pendingFields[index]];
+    cached.field = move(built[index]);
+    cached.queued = false;
+  }
+  pendingFields.erase(pendingFields.begin(),
+                      pendingFields.begin() + static_cast<ptrdiff_t>(fields));
+
+  if (pathCache.size() > PATH_CACHE_SIZE) {
+    // keep the most recently used three quarters, so this is rare
+    vector<uint64_t> uses;
+    for (auto const &[key, path] : pathCache) uses.push_back(path.lastUsed);
+    auto oldestKept = uses.end() - PATH_CACHE_SIZE * 3 / 4;
+    nth_element(uses.begin(), oldestKept, uses.end());
+    uint64_t oldest = *oldestKept;
+    erase_if(pathCache,
+             [&](auto const &entry) { return entry.second.lastUsed < oldest; });
+  }
+  while (fieldCache.size() > FIELD_CACHE_SIZE) {
+    auto oldest = fieldCache.end();
+    for (auto entry = fieldCache.begin(); entry != fieldCache.end(); ++entry)
+      if (!entry->second.queued &&
+          (oldest == fieldCache.end() ||
+           entry->second.lastUsed < oldest->second.lastUsed))
+        oldest = entry;
+    if (oldest == fieldCache.end()) break;
+    fieldCache.erase(oldest);
+  }
+}
+
+uint32_t Navigation::cellAt(float x, float y) noexcept {
+  float last = static_cast<float>(GRID - 1);
+  return cellOf(static_cast<int32_t>(clamp(x / CELL_SIZE, 0.0f, last)),
+                static_cast<int32_t>(clamp(y / CELL_SIZE, 0.0f, last)));
+}
+
+uint32_t Navigation::sectorOf(uint32_t cell) noexcept {
+  return static_cast<uint32_t>(yOf(cell) / SIDE) * SECTORS_PER_SIDE +
+         static_cast<uint32_t>(xOf(cell) / SIDE);
+}
+
+bool Navigation::open(int32_t x, int32_t y) const noexcept {
+  return x >= 0 && x < GRID && y >= 0 && y < GRID &&
+         coverage[cellOf(x, y)] == 0;
+}
+
+bool Navigation::canMove(uint32_t cell, size_t direction) const noexcept {
+  Move const &move = MOVES[direction];
+  int32_t x = xOf(cell);
+  int32_t y = yOf(cell);
+  if (!open(x + move.dx, y + move.dy)) return false;
+  // no cutting corners
+  return move.cost == STRAIGHT ||
+         (open(x + move.dx, y) && open(x, y + move.dy));
+}
+
+void Navigation::stamp(Footprint const &footprint, int32_t delta) noexcept {
+  float radiusSquared = footprint.radius * footprint.radius;
+  for (int32_t y = footprint.minY; y <= footprint.maxY; ++y) {
+    for (int32_t x = footprint.minX; x <= footprint.maxX; ++x) {
+      // from the centre to the nearest point of the cell
+      float left = static_cast<float>(x) * CELL_SIZE;
+      float top = static_cast<float>(y) * CELL_SIZE;
+      float dx = max({left - footprint.x, 0.0f,
+                      footprint.x - (left + CELL_SIZE)});
+      float dy = max({top - footprint.y, 0.0f,
+                      footprint.y - (top + CELL_SIZE)});
+      if (dx * dx + dy * dy >= radiusSquared) continue;
+
+      uint32_t cell = cellOf(x, y);
+      bool wasOpen = coverage[cell] == 0;
+      coverage[cell] = static_cast<uint16_t>(coverage[cell] + delta);
+      if (wasOpen != (coverage[cell] == 0)) dirty.set(sectorOf(cell));
+    }
+  }
+}
+
+uint32_t Navigation::search(uint32_t from, optional<uint32_t> to,
+                            span<uint32_t> costs,
+                            span<uint8_t> parents) const noexcept {
+  uint32_t sector = sectorOf(from);
+  int32_t left = static_cast<int32_t>(sector % SECTORS_PER_SIDE) * SIDE;
+  int32_t top = static_cast<int32_t>(sector / SECTORS_PER_SIDE) * SIDE;
+  fill(costs.begin(), costs.end(), UNREACHABLE);
+
+  Arena &arena = threadArena();
+  Arena::Scope scope(arena);
+  Frontier frontier{ArenaAllocator<pair<uint32_t, uint32_t>>(arena)};
+  // with a goal, A* - otherwise no estimate, so Dijkstra
+  auto estimate = [&](uint32_t cell) {
+    return to.has_value() ? octile(cell, *to) : 0;
+  };
+  costs[localOf(from)] = 0;
+  parents[localOf(from)] = NO_DIRECTION;
+  push(frontier, estimate(from), from);
+  while (!frontier.empty()) {
+    auto [priority, cell] = pop(frontier);
+    uint32_t cost = costs[localOf(cell)];
+    if (priority > cost + estimate(cell)) continue;
+    if (to == cell) return cost;
+    int32_t x = xOf(cell);
+    int32_t y = yOf(cell);
+    for (size_t direction = 0; direction < MOVES.size(); ++direction) {
+      Move const &move = MOVES[direction];
+      int32_t nextX = x + move.dx;
+      int32_t nextY = y + move.dy;
+      if (nextX < left || nextX >= left + SIDE || nextY < top ||
+          nextY >= top + SIDE || !canMove(cell, direction))
+        continue;
+      uint32_t next = cellOf(nextX, nextY);
+      if (cost + move.cost >= costs[localOf(next)]) continue;
+      costs[localOf(next)] = cost + move.cost;
+      parents[localOf(next)] = static_cast<uint8_t>(direction);
+      push(frontier, cost + move.cost + estimate(next), next);
+    }
+  }
+  return UNREACHABLE;
+}
+
+void Navigation::rebuildCluster(uint32_t sector) noexcept {
+  Cluster &cluster = clusters[sector];
+  cluster.nodes.clear();
+  cluster.edges.clear();
+  auto edgesOf = [&](uint32_t cell) -> vector<Edge> & {
+    auto found = find(cluster.nodes.begin(), cluster.nodes.end(), cell);
+    if (found != cluster.nodes.end())
+      return cluster.edges[static_cast<size_t>(found - cluster.nodes.begin())];
+    cluster.nodes.push_back(cell);
+    return cluster.edges.emplace_back();
+  };
+
+  // each border is scanned in the same order from either side, so both
+  // sectors agree on where its entrances are
+  int32_t left = static_cast<int32_t>(sector % SECTORS_PER_SIDE) * SIDE;
+  int32_t top = static_cast<int32_t>(sector / SECTORS_PER_SIDE) * SIDE;
+  for (auto [dx, dy] : {pair{1, 0}, pair{-1, 0}, pair{0, 1}, pair{0, -1}}) {
+    int32_t x = dx == 1 ? left + SIDE - 1 : left;
+    int32_t y = dy == 1 ? top + SIDE - 1 : top;
+    if (x + dx < 0 || x + dx >= GRID || y + dy < 0 || y + dy >= GRID) continue;
+    int32_t alongX = dx == 0 ? 1 : 0;
+    int32_t alongY = dy == 0 ? 1 : 0;
+    auto enter = [&](int32_t offset) {
+      int32_t cellX = x + alongX * offset;
+      int32_t cellY = y + alongY * offset;
+      edgesOf(cellOf(cellX, cellY))
+          .push_back(Edge{cellOf(cellX + dx, cellY + dy), STRAIGHT});
+    };
+
+    int32_t run = 0;  // clear crossings so far
+    for (int32_t offset = 0; offset <= SIDE; ++offset) {
+      int32_t cellX = x + alongX * offset;
+      int32_t cellY = y + alongY * offset;
+      if (offset < SIDE && open(cellX, cellY) &&
+          open(cellX + dx, cellY + dy)) {
+        ++run;
+        continue;
+      }
+      if (run >= WIDE_ENTRANCE) {
+        enter(offset - run);
+        enter(offset - 1);
+      } else if (run > 0) {
+        enter(offset - run + (run - 1) / 2);
+      }
+      run = 0;
+    }
+  }
+
+  Arena &arena = threadArena();
+  Arena::Scope scope(arena);
+  span<uint32_t> costs = arena.allocate<uint32_t>(SECTOR_CELLS);
+  span<uint8_t> parents = arena.allocate<uint8_t>(SECTOR_CELLS);
+  for (size_t from = 0; from < cluster.nodes.size(); ++from) {
+    search(cluster.nodes[from], nullopt, costs, parents);
+    for (size_t to = 0; to < cluster.nodes.size(); ++to) {
+      uint32_t cost = costs[localOf(cluster.nodes[to])];
+      if (to != from && cost != UNREACHABLE)
+        cluster.edges[from].push_back(Edge{cluster.nodes[to], cost});
+    }
+  }
+}
+
+uint32_t Navigation::nodeId(uint32_t cell) const noexcept {
+  uint32_t sector = sectorOf(cell);
+  vector<uint32_t> const &nodes = clusters[sector].nodes;
+  return nodeBases[sector] + static_cast<uint32_t>(
+                                 find(nodes.begin(), nodes.end(), cell) -
+                                 nodes.begin());
+}
+
+bool Navigation::findPath(uint32_t from, uint32_t to,
+                          vector<uint32_t> &waypoints,
+                          bitset<SECTORS> &sectors) const noexcept {
+  waypoints.clear();
+  sectors.reset();
+  if (coverage[to] != 0) return false;
+
+  Arena &arena = threadArena();
+  Arena::Scope scope(arena);
+  span<uint32_t> costs = arena.allocate<uint32_t>(SECTOR_CELLS);
+  span<uint8_t> parents = arena.allocate<uint8_t>(SECTOR_CELLS);
+  ArenaVector<uint32_t> cells{ArenaAllocator<uint32_t>(arena)};
+  cells.push_back(from);
+  // appends the cells after a, up to b, once searched from a
+  auto walk = [&](uint32_t a, uint32_t b) {
+    size_t first = cells.size();
+    for (uint32_t cell = b; cell != a;) {
+      cells.push_back(cell);
+      Move const &move = MOVES[parents[localOf(cell)]];
+      cell = cellOf(xOf(cell) - move.dx, yOf(cell) - move.dy);
+    }
+    reverse(cells.begin() + static_cast<ptrdiff_t>(first), cells.end());
+  };
+
+  uint32_t fromSector = sectorOf(from);
+  uint32_t toSector = sectorOf(to);
+  if (fromSector == toSector &&
+      search(from, to, costs, parents) != UNREACHABLE) {
+    walk(from, to);
+  } else {
+    // A* over the entrances, with the start and goal joined to those of
+    // their sectors
+    uint32_t start = nodeBases.back();
+    uint32_t goal = start + 1;
+    auto cellOfNode = [&](uint32_t id) {
+      return id == start ? from : id == goal ? to : nodeCells[id];
+    };
+    Cluster const &first = clusters[fromSector];
+    Cluster const &last = clusters[toSector];
+    span<uint32_t> fromStart = arena.allocate<uint32_t>(first.nodes.size());
+    search(from, nullopt, costs, parents);
+    for (size_t index = 0; index < first.nodes.size(); ++index)
+      fromStart[index] = costs[localOf(first.nodes[index])];
+    span<uint32_t> toGoal = arena.allocate<uint32_t>(last.nodes.size());
+    search(to, nullopt, costs, parents);
+    for (size_t index = 0; index < last.nodes.size(); ++index)
+      toGoal[index] = costs[localOf(last.nodes[index])];
+
+    span<uint32_t> best = arena.allocate<uint32_t>(goal + 1);
+    span<uint32_t> previous = arena.allocate<uint32_t>(goal + 1);
+    fill(best.begin(), best.end(), UNREACHABLE);
+    Frontier frontier{ArenaAllocator<pair<uint32_t, uint32_t>>(arena)};
+    auto relax = [&](uint32_t id, uint32_t parent, uint32_t cost) {
+      if (cost >= best[id]) return;
+      best[id] = cost;
+      previous[id] = parent;
+      push(frontier, cost + octile(cellOfNode(id), to), id);
+    };
+    best[start] = 0;
+    push(frontier, octile(from, to), start);
+    bool found = false;
+    while (!frontier.empty()) {
+      auto [estimate, id] = pop(frontier);
+      uint32_t cost = best[id];
+      if (estimate > cost + octile(cellOfNode(id), to)) continue;
+      if (id == goal) {
+        found = true;
+        break;
+      }
+      if (id == start) {
+        for (size_t index = 0; index < first.nodes.size(); ++index)
+          if (fromStart[index] != UNREACHABLE)
+            relax(nodeBases[fromSector] + static_cast<uint32_t>(index), start,
+                  fromStart[index]);
+        continue;
+      }
+      uint32_t sector = sectorOf(nodeCells[id]);
+      uint32_t index = id - nodeBases[sector];
+      for (Edge const &edge : clusters[sector].edges[index])
+        relax(nodeId(edge.cell), id, cost + edge.cost);
+      if (sector == toSector && toGoal[index] != UNREACHABLE)
+        relax(goal, id, cost + toGoal[index]);
+    }
+    if (!found) return false;
+
+    ArenaVector<uint32_t> route{ArenaAllocator<uint32_t>(arena)};
+    for (uint32_t id = goal; id != start; id = previous[id])
+      route.push_back(cellOfNode(id));
+    uint32_t at = from;
+    for (auto cell = route.rbegin(); cell != route.rend(); ++cell) {
+      // a leg within a sector, or a crossing to the next
+      if (sectorOf(*cell) == sectorOf(at)) {
+        search(at, *cell, costs, parents);
+        walk(at, *cell);
+      } else {
+        cells.push_back(*cell);
+      }
+      at = *cell;
+    }
+  }
+
+  // only the cells it turns at, then only those a straight line can't skip
+  ArenaVector<uint32_t> turns{ArenaAllocator<uint32_t>(arena)};
+  for (size_t index = 1; index < cells.size(); ++index)
+    if (index + 1 == cells.size() ||
+        cells[index] - cells[index - 1] != cells[index + 1] - cells[index])
+      turns.push_back(cells[index]);
+  auto clear = [&](int32_t x, int32_t y) { return open(x, y); };
+  uint32_t anchor = from;
+  for (size_t index = 0; index < turns.size(); ++index) {
+    if (index + 1 < turns.size() && traverse(anchor, turns[index + 1], clear))
+      continue;
+    waypoints.push_back(turns[index]);
+    anchor = turns[index];
+  }
+
+  sectors.set(fromSector);
+  uint32_t at = from;
+  for (uint32_t waypoint : waypoints) {
+    traverse(at, waypoint, [&](int32_t x, int32_t y) {
+      sectors.set(sectorOf(cellOf(x, y)));
+      return true;
+    });
+    at = waypoint;
+  }
+  return true;
+}
+
+shared_ptr<Navigation::FlowField const> Navigation::buildField(
+    uint32_t goal) const noexcept {
+  shared_ptr<FlowField> field(new FlowField(goal, version));
+  if (coverage[goal] != 0) return field;
+
+  // Dijkstra outward from the goal - every move can be made either way, so
+  // each cell heads back along the move that reached it
+  Arena &arena = threadArena();
+  Arena::Scope scope(arena);
+  Frontier frontier{ArenaAllocator<pair<uint32_t, uint32_t>>(arena)};
+  field->costs[goal] = 0;
+  push(frontier, 0, goal);
+  while (!frontier.empty()) {
+    auto [cost, cell] = pop(frontier);
+    if (cost > field->costs[cell]) continue;
+    for (size_t direction = 0; direction < MOVES.size(); ++direction) {
+      if (!canMove(cell, direction)) continue;
+      Move const &move = MOVES[direction];
+      uint32_t next = cellOf(xOf(cell) + move.dx, yOf(cell) + move.dy);
+      if (cost + move.cost >= field->costs[next]) continue;
+      field->costs[next] = cost + move.cost;
+      field->directions[next] = static_cast<uint8_t>((direction + 4) % 8);
+      push(frontier, cost + move.cost, next);
+    }
+  }
+  return field;
+}
+
+vector<Position> Navigation::answer(CachedPath const &path, float toX,
+                                    float toY) noexcept {
+  vector<Position> waypoints;
+  if (!path.reachable) return waypoints;
+  for (uint32_t cell : path.waypoints)
+    waypoints.push_back(Position{centreOf(xOf(cell)), centreOf(yOf(cell))});
+  if (waypoints.empty()) waypoints.emplace_back();
+  waypoints.back() = Position{toX, toY};
+  return waypoints;
+}
+}  // namespace carrier_conquest::game
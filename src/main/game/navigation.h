@@ -0,0 +1,223 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_GAME_NAVIGATION_H_
+#define CARRIERCONQUEST_GAME_NAVIGATION_H_
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "game/components.h"
+#include "game/entity.h"
+
+namespace carrier_conquest::game {
+// fleet pathfinding over the campaign map
+// the map is a grid of cells, blocked wherever an obstacle covers them; each
+// sector's cells form a cluster, and a path is planned (hierarchical A*) over
+// the crossings between neighbouring sectors before each leg is refined
+// within its sector
+// many units headed to one place share a flow field instead - the way to go
+// from every cell
+// obstacle changes are incremental: only sectors where a cell changes
+// between blocked and clear are rebuilt, and only the cached paths through
+// them are dropped
+// queries are queued, then answered in batches by update, spread over the
+// job system - the budget is a count, not a time, so answers arrive on the
+// same tick every run
+// not thread-safe - use from the thread that steps the simulation
+class Navigation final {
+ public:
+  using Ticket = uint64_t;
+
+  // a unit vector
+  struct Heading final {
+    float x;
+    float y;
+  };
+
+  // the way to the goal cell from every other cell, and how far it is
+  class FlowField final {
+   public:
+    FlowField(FlowField const &) noexcept = delete;
+    FlowField(FlowField &&) noexcept = delete;
+
+    ~FlowField() noexcept = default;
+
+    FlowField &operator=(FlowField const &) noexcept = delete;
+    FlowField &operator=(FlowField &&) noexcept = delete;
+
+    // zero in the goal cell, and where the goal can't be reached
+    Heading heading(float x, float y) const noexcept;
+    // metres, travelling cell to cell - infinite if unreachable
+    float distance(float x, float y) const noexcept;
+
+   private:
+    friend class Navigation;
+
+    FlowField(uint32_t goal, uint64_t version) noexcept;
+
+    uint32_t goal;
+    uint64_t version;  // of the grid it was built from
+    std::vector<uint32_t> costs;
+    std::vector<uint8_t> directions;
+  };
+
+  // every cell starts clear - the graph is built by the first update
+  Navigation() noexcept;
+  Navigation(Navigation const &) noexcept = delete;
+  Navigation(Navigation &&) noexcept = default;
+
+  ~Navigation() noexcept = default;
+
+  Navigation &operator=(Navigation const &) noexcept = delete;
+  Navigation &operator=(Navigation &&) noexcept = default;
+
+  // obstacles are circles, each belonging to an entity - setting one that's
+  // already there moves it, and takes effect at the next update
+  void setObstacle(Entity entity, float x, float y, float radius) noexcept;
+  void removeObstacle(Entity entity) noexcept;
+  bool passable(float x, float y) const noexcept;
+
+  // queues a path query, answered by a later update - or at once, if cached
+  Ticket requestPath(float fromX, float fromY, float toX,
+                     float toY) noexcept;
+  // the waypoints after the start, ending at the goal - empty if the goal
+  // can't be reached - or nullopt if not answered yet; taken only once
+  std::optional<std::vector<Position>> takePath(Ticket ticket) noexcept;
+
+  // the flow field toward the cell holding (x, y) - if it's missing or out
+  // of date, a new one is queued, and until it's built the old one (or
+  // nullptr) is returned
+  std::shared_ptr<FlowField const> flowField(float x, float y) noexcept;
+
+  // applies obstacle changes, then answers up to PATHS_PER_TICK queued path
+  // queries and builds up to FIELDS_PER_TICK flow fields - call once a tick
+  void update() noexcept;
+
+  static constexpr uint32_t SECTORS_PER_SIDE = 16;  // as in generation
+  static constexpr uint32_t SECTORS = SECTORS_PER_SIDE * SECTORS_PER_SIDE;
+  static constexpr uint32_t CELLS_PER_SECTOR = 16;  // along each side
+  static constexpr uint32_t GRID_SIZE = SECTORS_PER_SIDE * CELLS_PER_SECTOR;
+  static constexpr size_t PATHS_PER_TICK = 64;
+  static constexpr size_t FIELDS_PER_TICK = 2;
+  static constexpr size_t PATH_CACHE_SIZE = 4096;
+  static constexpr size_t FIELD_CACHE_SIZE = 16;
+
+ private:
+  // a circle, and the cells it might cover
+  struct Footprint final {
+    Entity entity;  // Entity::NONE if there's no obstacle
+    float x;
+    float y;
+    float radius;
+    int32_t minX;
+    int32_t minY;
+    int32_t maxX;
+    int32_t maxY;
+  };
+
+  struct Edge final {
+    uint32_t cell;
+    uint32_t cost;
+  };
+
+  // a sector's entrances - cells next to a clear cell across its border -
+  // with their crossings to the next sector, and the cost between each pair
+  // within the sector
+  struct Cluster final {
+    std::vector<uint32_t> nodes;  // cells
+    std::vector<std::vector<Edge>> edges;
+  };
+
+  struct CachedPath final {
+    bool reachable;
+    std::vector<uint32_t> waypoints;  // cells
+    std::bitset<SECTORS> sectors;     // crossed by the path
+    uint64_t lastUsed;
+  };
+
+  struct CachedField final {
+    std::shared_ptr<FlowField const> field;
+    bool queued;
+    uint64_t lastUsed;
+  };
+
+  struct PathQuery final {
+    Ticket ticket;
+    uint32_t from;
+    uint32_t to;
+    float toX;
+    float toY;
+  };
+
+  // obstacles over each cell
+  std::vector<uint16_t> coverage;
+  std::vector<Footprint> obstacles;  // by entity index
+  std::bitset<SECTORS> dirty;        // since the last update
+  uint64_t version;                  // bumped whenever a cell changes
+
+  std::vector<Cluster> clusters;
+  // the abstract graph's nodes, numbered cluster by cluster
+  std::vector<uint32_t> nodeBases;
+  std::vector<uint32_t> nodeCells;
+
+  uint64_t clock;  // for evicting the least recently used
+  std::unordered_map<uint64_t, CachedPath> pathCache;
+  std::unordered_map<uint32_t, CachedField> fieldCache;
+
+  Ticket nextTicket;
+  std::deque<PathQuery> pendingPaths;
+  std::deque<uint32_t> pendingFields;
+  std::unordered_map<Ticket, std::vector<Position>> answers;
+
+  static uint32_t cellAt(float x, float y) noexcept;
+  static uint32_t sectorOf(uint32_t cell) noexcept;
+
+  bool open(int32_t x, int32_t y) const noexcept;
+  bool canMove(uint32_t cell, size_t direction) const noexcept;
+  void stamp(Footprint const &footprint, int32_t delta) noexcept;
+
+  // searches from a cell, within its sector, into costs and parents (the
+  // direction each cell was reached by), by cell within the sector
+  // stops at to, if given, and returns the cost to it
+  uint32_t search(uint32_t from, std::optional<uint32_t> to,
+                  std::span<uint32_t> costs,
+                  std::span<uint8_t> parents) const noexcept;
+  void rebuildCluster(uint32_t sector) noexcept;
+  uint32_t nodeId(uint32_t cell) const noexcept;
+
+  // the path between the cells, smoothed down to the cells it turns at, and
+  // the sectors it crosses - false if there's no path
+  bool findPath(uint32_t from, uint32_t to, std::vector<uint32_t> &waypoints,
+                std::bitset<SECTORS> &sectors) const noexcept;
+  std::shared_ptr<FlowField const> buildField(uint32_t goal) const noexcept;
+
+  static std::vector<Position> answer(CachedPath const &path, float toX,
+                                      float toY) noexcept;
+};
+}  // namespace carrier_conquest::game
+
+#endif  // CARRIERCONQUEST_GAME_NAVIGATION_H_
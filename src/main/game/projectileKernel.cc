@@ -0,0 +1,235 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "game/projectileKernel.h"
+
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace carrier_conquest::game {
+namespace {
+using Kernel = void (*)(ProjectileLanes const &, size_t, size_t, float);
+
+Kernel selectKernel() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) return advanceProjectilesAvx2;
+  if (__builtin_cpu_supports("sse4.1")) return advanceProjectilesSse41;
+#endif
+  return advanceProjectilesScalar;
+}
+}  // namespace
+
+void advanceProjectiles(ProjectileLanes const &lanes, size_t begin,
+                        size_t end, float dt) noexcept {
+  static Kernel const kernel = selectKernel();
+  kernel(lanes, begin, end, dt);
+}
+
+void advanceProjectilesScalar(ProjectileLanes const &lanes, size_t begin,
+                              size_t end, float dt) noexcept {
+  for (size_t index = begin; index < end; ++index) {
+    float x = lanes.x[index];
+    float y = lanes.y[index];
+    float vx = lanes.vx[index];
+    float vy = lanes.vy[index];
+    float cosTurn = lanes.cosTurn[index];
+    float sinTurn = lanes.sinTurn[index];
+
+    // current heading, and the heading straight at the target
+    float speed = sqrt(vx * vx + vy * vy);
+    float hx = vx / speed;
+    float hy = vy / speed;
+    float dx = lanes.targetX[index] - x;
+    float dy = lanes.targetY[index] - y;
+    float distance = sqrt(dx * dx + dy * dy);
+    float ux = dx / distance;
+    float uy = dy / distance;
+
+    // turn onto the target if it's within this step's turn, or else as far
+    // towards it as allowed
+    float dot = hx * ux + hy * uy;
+    float cross = hx * uy - hy * ux;
+    float sign = cross < 0.0f ? -1.0f : 1.0f;
+    float rx = hx * cosTurn - (sign * hy) * sinTurn;
+    float ry = hy * cosTurn + (sign * hx) * sinTurn;
+    bool direct = dot >= cosTurn;
+    float nx = direct ? ux : rx;
+    float ny = direct ? uy : ry;
+
+    bool steer = sinTurn > 0.0f && distance > 0.0f && speed > 0.0f;
+    vx = steer ? nx * speed : vx;
+    vy = steer ? ny * speed : vy;
+    bool arrived = distance <= speed * dt;
+
+    lanes.x[index] = x + vx * dt;
+    lanes.y[index] = y + vy * dt;
+    lanes.vx[index] = vx;
+    lanes.vy[index] = vy;
+    float lifetime = lanes.lifetime[index] - dt;
+    lanes.lifetime[index] = lifetime;
+    lanes.flags[index] =
+        static_cast<uint8_t>((lifetime <= 0.0f ? PROJECTILE_EXPIRED : 0) |
+                             (arrived ? PROJECTILE_ARRIVED : 0));
+  }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("sse4.1"))) void advanceProjectilesSse41(
+    ProjectileLanes const &lanes, size_t begin, size_t end,
+    float dt) noexcept {
+  constexpr size_t WIDTH = 4;
+  __m128 const zero = _mm_setzero_ps();
+  __m128 const one = _mm_set1_ps(1.0f);
+  __m128 const negativeOne = _mm_set1_ps(-1.0f);
+  __m128 const step = _mm_set1_ps(dt);
+
+  size_t index = begin;
+  for (; index + WIDTH <= end; index += WIDTH) {
+    __m128 x = _mm_loadu_ps(lanes.x + index);
+    __m128 y = _mm_loadu_ps(lanes.y + index);
+    __m128 vx = _mm_loadu_ps(lanes.vx + index);
+    __m128 vy = _mm_loadu_ps(lanes.vy + index);
+    __m128 cosTurn = _mm_loadu_ps(lanes.cosTurn + index);
+    __m128 sinTurn = _mm_loadu_ps(lanes.sinTurn + index);
+
+    __m128 speed =
+        _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)));
+    __m128 hx = _mm_div_ps(vx, speed);
+    __m128 hy = _mm_div_ps(vy, speed);
+    __m128 dx = _mm_sub_ps(_mm_loadu_ps(lanes.targetX + index), x);
+    __m128 dy = _mm_sub_ps(_mm_loadu_ps(lanes.targetY + index), y);
+    __m128 distance =
+        _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+    __m128 ux = _mm_div_ps(dx, distance);
+    __m128 uy = _mm_div_ps(dy, distance);
+
+    __m128 dot = _mm_add_ps(_mm_mul_ps(hx, ux), _mm_mul_ps(hy, uy));
+    __m128 cross = _mm_sub_ps(_mm_mul_ps(hx, uy), _mm_mul_ps(hy, ux));
+    __m128 sign = _mm_blendv_ps(one, negativeOne, _mm_cmplt_ps(cross, zero));
+    __m128 rx = _mm_sub_ps(_mm_mul_ps(hx, cosTurn),
+                           _mm_mul_ps(_mm_mul_ps(sign, hy), sinTurn));
+    __m128 ry = _mm_add_ps(_mm_mul_ps(hy, cosTurn),
+                           _mm_mul_ps(_mm_mul_ps(sign, hx), sinTurn));
+    __m128 direct = _mm_cmpge_ps(dot, cosTurn);
+    __m128 nx = _mm_blendv_ps(rx, ux, direct);
+    __m128 ny = _mm_blendv_ps(ry, uy, direct);
+
+    __m128 steer = _mm_and_ps(
+        _mm_cmpgt_ps(sinTurn, zero),
+        _mm_and_ps(_mm_cmpgt_ps(distance, zero), _mm_cmpgt_ps(speed, zero)));
+    vx = _mm_blendv_ps(vx, _mm_mul_ps(nx, speed), steer);
+    vy = _mm_blendv_ps(vy, _mm_mul_ps(ny, speed), steer);
+    __m128 arrived = _mm_cmple_ps(distance, _mm_mul_ps(speed, step));
+
+    _mm_storeu_ps(lanes.x + index, _mm_add_ps(x, _mm_mul_ps(vx, step)));
+    _mm_storeu_ps(lanes.y + index, _mm_add_ps(y, _mm_mul_ps(vy, step)));
+    _mm_storeu_ps(lanes.vx + index, vx);
+    _mm_storeu_ps(lanes.vy + index, vy);
+    __m128 lifetime = _mm_sub_ps(_mm_loadu_ps(lanes.lifetime + index), step);
+    _mm_storeu_ps(lanes.lifetime + index, lifetime);
+
+    int expiredMask = _mm_movemask_ps(_mm_cmple_ps(lifetime, zero));
+    int arrivedMask = _mm_movemask_ps(arrived);
+    for (size_t lane = 0; lane < WIDTH; ++lane)
+      lanes.flags[index + lane] = static_cast<uint8_t>(
+          ((expiredMask >> lane) & 1 ? PROJECTILE_EXPIRED : 0) |
+          ((arrivedMask >> lane) & 1 ? PROJECTILE_ARRIVED : 0));
+  }
+  advanceProjectilesScalar(lanes, index, end, dt);
+}
+
+__attribute__((target("avx2"))) void advanceProjectilesAvx2(
+    ProjectileLanes const &lanes, size_t begin, size_t end,
+    float dt) noexcept {
+  constexpr size_t WIDTH = 8;
+  __m256 const zero = _mm256_setzero_ps();
+  __m256 const one = _mm256_set1_ps(1.0f);
+  __m256 const negativeOne = _mm256_set1_ps(-1.0f);
+  __m256 const step = _mm256_set1_ps(dt);
+
+  size_t index = begin;
+  for (; index + WIDTH <= end; index += WIDTH) {
+    __m256 x = _mm256_loadu_ps(lanes.x + index);
+    __m256 y = _mm256_loadu_ps(lanes.y + index);
+    __m256 vx = _mm256_loadu_ps(lanes.vx + index);
+    __m256 vy = _mm256_loadu_ps(lanes.vy + index);
+    __m256 cosTurn = _mm256_loadu_ps(lanes.cosTurn + index);
+    __m256 sinTurn = _mm256_loadu_ps(lanes.sinTurn + index);
+
+    __m256 speed = _mm256_sqrt_ps(
+        _mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy)));
+    __m256 hx = _mm256_div_ps(vx, speed);
+    __m256 hy = _mm256_div_ps(vy, speed);
+    __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(lanes.targetX + index), x);
+    __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(lanes.targetY + index), y);
+    __m256 distance = _mm256_sqrt_ps(
+        _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+    __m256 ux = _mm256_div_ps(dx, distance);
+    __m256 uy = _mm256_div_ps(dy, distance);
+
+    __m256 dot = _mm256_add_ps(_mm256_mul_ps(hx, ux), _mm256_mul_ps(hy, uy));
+    __m256 cross =
+        _mm256_sub_ps(_mm256_mul_ps(hx, uy), _mm256_mul_ps(hy, ux));
+    __m256 sign = _mm256_blendv_ps(one, negativeOne,
+                                   _mm256_cmp_ps(cross, zero, _CMP_LT_OQ));
+    __m256 rx = _mm256_sub_ps(_mm256_mul_ps(hx, cosTurn),
+                              _mm256_mul_ps(_mm256_mul_ps(sign, hy), sinTurn));
+    __m256 ry = _mm256_add_ps(_mm256_mul_ps(hy, cosTurn),
+                              _mm256_mul_ps(_mm256_mul_ps(sign, hx), sinTurn));
+    __m256 direct = _mm256_cmp_ps(dot, cosTurn, _CMP_GE_OQ);
+    __m256 nx = _mm256_blendv_ps(rx, ux, direct);
+    __m256 ny = _mm256_blendv_ps(ry, uy, direct);
+
+    __m256 steer =
+        _mm256_and_ps(_mm256_cmp_ps(sinTurn, zero, _CMP_GT_OQ),
+                      _mm256_and_ps(_mm256_cmp_ps(distance, zero, _CMP_GT_OQ),
+                                    _mm256_cmp_ps(speed, zero, _CMP_GT_OQ)));
+    vx = _mm256_blendv_ps(vx, _mm256_mul_ps(nx, speed), steer);
+    vy = _mm256_blendv_ps(vy, _mm256_mul_ps(ny, speed), steer);
+    __m256 arrived =
+        _mm256_cmp_ps(distance, _mm256_mul_ps(speed, step), _CMP_LE_OQ);
+
+    _mm256_storeu_ps(lanes.x + index,
+                     _mm256_add_ps(x, _mm256_mul_ps(vx, step)));
+    _mm256_storeu_ps(lanes.y + index,
+                     _mm256_add_ps(y, _mm256_mul_ps(vy, step)));
+    _mm256_storeu_ps(lanes.vx + index, vx);
+    _mm256_storeu_ps(lanes.vy + index, vy);
+    __m256 lifetime =
+        _mm256_sub_ps(_mm256_loadu_ps(lanes.lifetime + index), step);
+    _mm256_storeu_ps(lanes.lifetime + index, lifetime);
+
+    int expiredMask =
+        _mm256_movemask_ps(_mm256_cmp_ps(lifetime, zero, _CMP_LE_OQ));
+    int arrivedMask = _mm256_movemask_ps(arrived);
+    for (size_t lane = 0; lane < WIDTH; ++lane)
+      lanes.flags[index + lane] = static_cast<uint8_t>(
+          ((expiredMask >> lane) & 1 ? PROJECTILE_EXPIRED : 0) |
+          ((arrivedMask >> lane) & 1 ? PROJECTILE_ARRIVED : 0));
+  }
+  advanceProjectilesScalar(lanes, index, end, dt);
+}
+#endif
+}  // namespace carrier_conquest::game
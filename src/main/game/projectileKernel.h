@@ -0,0 +1,66 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_GAME_PROJECTILEKERNEL_H_
+#define CARRIERCONQUEST_GAME_PROJECTILEKERNEL_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace carrier_conquest::game {
+// projectiles in struct-of-arrays form, as the integration kernel takes them
+struct ProjectileLanes final {
+  float *x;
+  float *y;
+  float *vx;
+  float *vy;
+  // NaN if there's no target
+  float const *targetX;
+  float const *targetY;
+  // most a projectile may turn this step - sinTurn is zero if unguided
+  float const *cosTurn;
+  float const *sinTurn;
+  float *lifetime;
+  uint8_t *flags;  // out
+};
+
+constexpr uint8_t PROJECTILE_EXPIRED = 0x1;
+constexpr uint8_t PROJECTILE_ARRIVED = 0x2;  // reached its target this step
+
+// steers guided projectiles towards their targets, moves every projectile by
+// dt seconds, and ages them, flagging the ones that expired or arrived
+// guided or not, a projectile arrives once its target is within this step's
+// travel
+// picks the widest version the CPU supports; all of them produce
+// bit-identical results - they only use correctly
+// rounded operations, in the same order, with no fused multiply-adds
+void advanceProjectiles(ProjectileLanes const &lanes, size_t begin,
+                        size_t end, float dt) noexcept;
+
+void advanceProjectilesScalar(ProjectileLanes const &lanes, size_t begin,
+                              size_t end, float dt) noexcept;
+#if defined(__x86_64__) || defined(__i386__)
+void advanceProjectilesSse41(ProjectileLanes const &lanes, size_t begin,
+                             size_t end, float dt) noexcept;
+void advanceProjectilesAvx2(ProjectileLanes const &lanes, size_t begin,
+                            size_t end, float dt) noexcept;
+#endif
+}  // namespace carrier_conquest::game
+
+#endif  // CARRIERCONQUEST_GAME_PROJECTILEKERNEL_H_
@@ -0,0 +1,109 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "game/projectiles.h"
+
+#include <cassert>
+#include <limits>
+#include <span>
+
+#include "game/detMath.h"
+#include "game/projectileKernel.h"
+#include "util/arena.h"
+#include "util/jobSystem.h"
+
+using namespace std;
+using namespace carrier_conquest::util;
+
+namespace carrier_conquest::game {
+namespace {
+// projectiles per job
+constexpr size_t GRAIN = 2048;
+constexpr float NO_TARGET = numeric_limits<float>::quiet_NaN();
+}  // namespace
+
+void updateProjectiles(World &world, float dt) noexcept {
+  ComponentStore<Projectile> &projectiles = world.store<Projectile>();
+  size_t count = projectiles.size();
+  if (count == 0) return;
+  span<Entity const> entities = projectiles.getEntities();
+  span<Projectile> components = projectiles.getComponents();
+
+  Arena &arena = threadArena();
+  Arena::Scope scope(arena);
+  span<float> floats = arena.allocate<float>(count * 9);
+  span<uint8_t> flags = arena.allocate<uint8_t>(count);
+  auto lane = [&](size_t which) { return floats.data() + which * count; };
+  ProjectileLanes lanes{lane(0), lane(1), lane(2), lane(3), lane(4),
+                        lane(5), lane(6), lane(7), lane(8), flags.data()};
+
+  // gather everything before moving anything, since a projectile's target
+  // may itself be a projectile
+  jobs->parallelFor(count, GRAIN, [&](size_t begin, size_t end) {
+    for (size_t index = begin; index < end; ++index) {
+      Projectile const &projectile = components[index];
+      Position const *position = world.get<Position>(entities[index]);
+      Velocity const *velocity = world.get<Velocity>(entities[index]);
+      assert(position != nullptr && velocity != nullptr &&
+             "projectiles must have a position and velocity");
+      lanes.x[index] = position->x;
+      lanes.y[index] = position->y;
+      lanes.vx[index] = velocity->x;
+      lanes.vy[index] = velocity->y;
+      lanes.lifetime[index] = projectile.lifetime;
+
+      // unguided projectiles still need their target, to tell when they hit
+      Position const *target = world.get<Position>(projectile.target);
+      SinCos turn = target != nullptr && projectile.turnRate > 0.0f
+                        ? sinCos(toAngle(projectile.turnRate * dt))
+                        : SinCos{0.0f, 1.0f};
+      lane(4)[index] = target != nullptr ? target->x : NO_TARGET;
+      lane(5)[index] = target != nullptr ? target->y : NO_TARGET;
+      lane(6)[index] = turn.cos;
+      lane(7)[index] = turn.sin;
+    }
+  });
+
+  jobs->parallelFor(count, GRAIN, [&](size_t begin, size_t end) {
+    advanceProjectiles(lanes, begin, end, dt);
+    for (size_t index = begin; index < end; ++index) {
+      Position *position = world.get<Position>(entities[index]);
+      Velocity *velocity = world.get<Velocity>(entities[index]);
+      position->x = lanes.x[index];
+      position->y = lanes.y[index];
+      velocity->x = lanes.vx[index];
+      velocity->y = lanes.vy[index];
+      components[index].lifetime = lanes.lifetime[index];
+    }
+  });
+
+  ArenaVector<Entity> spent{ArenaAllocator<Entity>(arena)};
+  for (size_t index = 0; index < count; ++index) {
+    if ((flags[index] & PROJECTILE_ARRIVED) != 0) {
+      if (Hull *hull = world.get<Hull>(components[index].target);
+          hull != nullptr)
+        hull->integrity -= components[index].damage;
+      spent.push_back(entities[index]);
+    } else if ((flags[index] & PROJECTILE_EXPIRED) != 0) {
+      spent.push_back(entities[index]);
+    }
+  }
+  for (Entity entity : spent) world.destroy(entity);
+}
+}  // namespace carrier_conquest::game
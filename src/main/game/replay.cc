@@ -0,0 +1,303 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "game/replay.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <system_error>
+
+#include "game/game.h"
+#include "util/exceptions/loadException.h"
+
+using namespace std;
+using namespace std::filesystem;
+using namespace carrier_conquest::util;
+using namespace carrier_conquest::util::exceptions;
+
+namespace carrier_conquest::game {
+namespace {
+uint64_t alignUp(uint64_t offset) noexcept {
+  return (offset + SAVE_ALIGNMENT - 1) / SAVE_ALIGNMENT * SAVE_ALIGNMENT;
+}
+
+uint32_t checksum(ReplayHeader header, span<ReplayKeyframe const> keyframes,
+                  span<Command const> commands) noexcept {
+  header.checksum = 0;
+  uLong crc = crc32_z(0, reinterpret_cast<Bytef const *>(&header),
+                      sizeof(header));
+  if (!keyframes.empty())
+    crc = crc32_z(crc, reinterpret_cast<Bytef const *>(keyframes.data()),
+                  keyframes.size_bytes());
+  if (!commands.empty())
+    crc = crc32_z(crc, reinterpret_cast<Bytef const *>(commands.data()),
+                  commands.size_bytes());
+  return static_cast<uint32_t>(crc);
+}
+
+[[noreturn]] void invalid(path const &filename, string const &why) {
+  throw LoadException("Could not read replay", filename.string() + why);
+}
+}  // namespace
+
+ReplayRecorder::ReplayRecorder() noexcept
+    : commands(),
+      keyframes(),
+      sparseInterval(SPARSE_INTERVAL),
+      image(),
+      encoded(),
+      encoding(),
+      writing() {}
+
+ReplayRecorder::~ReplayRecorder() noexcept {
+  finishKeyframe();
+  wait();
+}
+
+void ReplayRecorder::keyframe(World const &world,
+                              SaveInfo const &info) noexcept {
+  // the last one's had a whole interval to finish
+  finishKeyframe();
+  captureSave(world, info, image);
+  auto save = make_shared<vector<std::byte>>();
+  encoded = Keyframe{info.ticks, save};
+  encoding = jobs->submit(
+      [this, save](stop_token const &) { encodeSave(image, *save); }, {},
+      JobSystem::Affinity::WORKERS);
+}
+
+void ReplayRecorder::record(Command const &command) noexcept {
+  commands.push_back(command);
+}
+
+void ReplayRecorder::save(path const &filename, uint64_t endTick) noexcept {
+  if (keyframes.empty() && encoding == nullptr) return;
+
+  // the writer gets its own copy of the log, and shares the keyframes - one
+  // still being encoded is waited for by the writer, not by this thread
+  Keyframe pending = encoding != nullptr ? encoded : Keyframe{};
+  auto write = [filename, endTick, commands = commands, keyframes = keyframes,
+                pending = move(pending)](stop_token const &) mutable {
+    // empty if the job was cancelled at shutdown
+    if (pending.save != nullptr && !pending.save->empty())
+      keyframes.push_back(move(pending));
+    if (keyframes.empty()) return;
+
+    ReplayHeader header{};
+    memcpy(header.magic, REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+    header.version = REPLAY_VERSION;
+    header.keyframeCount = static_cast<uint32_t>(keyframes.size());
+    header.commandCount = commands.size();
+    header.startTick = keyframes.front().tick;
+    header.endTick = endTick;
+
+    vector<ReplayKeyframe> table;
+    uint64_t offset = alignUp(sizeof(ReplayHeader) +
+                              keyframes.size() * sizeof(ReplayKeyframe) +
+                              commands.size() * sizeof(Command));
+    for (Keyframe const &keyframe : keyframes) {
+      table.push_back(
+          ReplayKeyframe{keyframe.tick, offset, keyframe.save->size()});
+      offset = alignUp(offset + keyframe.save->size());
+    }
+    header.checksum = checksum(header, table, commands);
+
+    vector<std::byte> bytes(offset, std::byte{0});
+    std::byte *out = bytes.data();
+    memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    memcpy(out, table.data(), table.size() * sizeof(ReplayKeyframe));
+    out += table.size() * sizeof(ReplayKeyframe);
+    if (!commands.empty())
+      memcpy(out, commands.data(), commands.size() * sizeof(Command));
+    for (size_t index = 0; index < keyframes.size(); ++index)
+      memcpy(bytes.data() + table[index].offset, keyframes[index].save->data(),
+             table[index].size);
+
+    try {
+      writeAtomically(filename, bytes);
+    } catch (system_error const &e) {
+      cerr << "ERROR: Could not save replay: " << e.what() << endl;
+    }
+  };
+  // and after any replay before it's written
+  writing = jobs->submit(move(write), {encoding, writing},
+                         JobSystem::Affinity::WORKERS);
+}
+
+void ReplayRecorder::wait() noexcept {
+  if (writing != nullptr) jobs->wait(writing);
+}
+
+void ReplayRecorder::finishKeyframe() noexcept {
+  if (encoding == nullptr) return;
+  jobs->wait(encoding);
+  encoding = nullptr;
+  // empty if the job was cancelled at shutdown
+  if (!encoded.save->empty()) {
+    keyframes.push_back(move(encoded));
+    thin();
+  }
+  encoded = Keyframe{};
+}
+
+void ReplayRecorder::thin() noexcept {
+  uint64_t now = keyframes.back().tick;
+  // the first keyframe is where the replay starts, so it's always kept
+  auto thinOut = [&]() {
+    size_t kept = 1;
+    for (size_t index = 1; index < keyframes.size(); ++index) {
+      Keyframe &keyframe = keyframes[index];
+      if (now - keyframe.tick >= RECENT_SPAN &&
+          keyframe.tick < keyframes[kept - 1].tick + sparseInterval)
+        continue;
+      if (kept != index) keyframes[kept] = move(keyframe);
+      ++kept;
+    }
+    keyframes.resize(kept);
+  };
+  thinOut();
+  // the recent keyframes alone fit, so this ends
+  while (keyframes.size() > MAX_KEYFRAMES) {
+    sparseInterval *= 2;
+    thinOut();
+  }
+}
+
+Replay::Replay(path const &filename_)
+    : world(),
+      spatialIndex(),
+      filename(filename_),
+      data(),
+      header(),
+      keyframes(),
+      commands(),
+      ticks(0),
+      nextCommand(0),
+      loaded(false) {
+  ifstream fin(filename, ios_base::in | ios_base::binary);
+  error_code error;
+  uint64_t size = file_size(filename, error);
+  if (!fin || error) invalid(filename, " could not be opened");
+  data.resize(size);
+  if (!fin.read(reinterpret_cast<char *>(data.data()),
+                static_cast<streamsize>(size)))
+    invalid(filename, " could not be read");
+
+  if (size < sizeof(ReplayHeader)) invalid(filename, " is truncated");
+  memcpy(&header, data.data(), sizeof(ReplayHeader));
+  if (memcmp(header.magic, REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) != 0)
+    invalid(filename, " is not a replay");
+  if (header.version != REPLAY_VERSION)
+    invalid(filename, " is from an incompatible version of the game");
+  uint64_t rest = size - sizeof(ReplayHeader);
+  if (header.keyframeCount == 0 ||
+      header.keyframeCount > rest / sizeof(ReplayKeyframe) ||
+      header.commandCount >
+          (rest - header.keyframeCount * sizeof(ReplayKeyframe)) /
+              sizeof(Command))
+    invalid(filename, " is truncated");
+
+  keyframes = span<ReplayKeyframe const>(
+      reinterpret_cast<ReplayKeyframe const *>(data.data() +
+                                               sizeof(ReplayHeader)),
+      header.keyframeCount);
+  commands = span<Command const>(
+      reinterpret_cast<Command const *>(keyframes.data() + keyframes.size()),
+      header.commandCount);
+  if (checksum(header, keyframes, commands) != header.checksum)
+    invalid(filename, " is corrupted");
+
+  for (size_t index = 0; index < keyframes.size(); ++index) {
+    ReplayKeyframe const &keyframe = keyframes[index];
+    if (keyframe.offset > size || keyframe.size > size - keyframe.offset)
+      invalid(filename, " is truncated");
+    if (keyframe.offset % SAVE_ALIGNMENT != 0 ||
+        (index == 0 ? keyframe.tick != header.startTick
+                    : keyframe.tick <= keyframes[index - 1].tick))
+      invalid(filename, " is corrupted");
+  }
+  if (!is_sorted(commands.begin(), commands.end(),
+                 [](Command const &a, Command const &b) {
+                   return a.tick < b.tick;
+                 }))
+    invalid(filename, " is corrupted");
+}
+
+uint64_t Replay::getStartTick() const noexcept { return header.startTick; }
+
+uint64_t Replay::getEndTick() const noexcept { return header.endTick; }
+
+span<Command const> Replay::getCommands() const noexcept { return commands; }
+
+uint64_t Replay::getTicks() const noexcept { return ticks; }
+
+void Replay::seek(uint64_t tick) {
+  tick = clamp(tick, header.startTick, max(header.startTick, header.endTick));
+  // the first keyframe is at the start, so there's always one at or before
+  ReplayKeyframe const &keyframe =
+      *prev(partition_point(keyframes.begin(), keyframes.end(),
+                            [&](ReplayKeyframe const &keyframe) {
+                              return keyframe.tick <= tick;
+                            }));
+
+  // a keyframe takes about as long to load as a few dozen ticks take to run
+  constexpr uint64_t LOAD_COST = 32;  // ticks
+  if (!loaded || tick < ticks ||
+      tick - ticks > tick - keyframe.tick + LOAD_COST) {
+    world = World();
+    SaveFile save(
+        span<std::byte const>(data).subspan(keyframe.offset, keyframe.size),
+        filename);
+    save.read(world);
+    spatialIndex.rebuild(world);
+    ticks = keyframe.tick;
+    loaded = true;
+
+    nextCommand = static_cast<size_t>(
+        partition_point(commands.begin(), commands.end(),
+                        [&](Command const &command) {
+                          return command.tick < ticks;
+                        }) -
+        commands.begin());
+    // selection isn't in keyframes, so restore it from before then
+    for (size_t index = nextCommand; index-- > 0;) {
+      if (commands[index].type == CommandType::SELECT) {
+        apply(world, commands[index]);
+        break;
+      }
+    }
+  }
+
+  while (true) {
+    for (; nextCommand < commands.size() &&
+           commands[nextCommand].tick <= ticks;
+         ++nextCommand)
+      apply(world, commands[nextCommand]);
+    if (ticks == tick) break;
+    step(world, spatialIndex);
+    ++ticks;
+  }
+}
+}  // namespace carrier_conquest::game
@@ -0,0 +1,138 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_GAME_REPLAY_H_
+#define CARRIERCONQUEST_GAME_REPLAY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "game/command.h"
+#include "game/saveFile.h"
+#include "game/saveFormat.h"
+#include "game/spatialIndex.h"
+#include "game/world.h"
+#include "util/jobSystem.h"
+
+namespace carrier_conquest::game {
+// records a game's commands and keyframes as it's played, to be written out
+// as a replay - call from the thread that owns the game state
+class ReplayRecorder final {
+ public:
+  ReplayRecorder() noexcept;
+  ReplayRecorder(ReplayRecorder const &) noexcept = delete;
+  ReplayRecorder(ReplayRecorder &&) noexcept = delete;
+
+  // waits for any keyframe or replay in progress
+  ~ReplayRecorder() noexcept;
+
+  ReplayRecorder &operator=(ReplayRecorder const &) noexcept = delete;
+  ReplayRecorder &operator=(ReplayRecorder &&) noexcept = delete;
+
+  // copies world, and starts encoding it in the background - the first
+  // keyframe is where the replay starts
+  void keyframe(World const &world, SaveInfo const &info) noexcept;
+  void record(Command const &command) noexcept;
+  // starts writing everything recorded so far, up to endTick, once any
+  // replay in progress is written - without waiting for either
+  void save(std::filesystem::path const &filename, uint64_t endTick) noexcept;
+  // waits for the last replay to be written
+  void wait() noexcept;
+
+  // a seek within the last RECENT_SPAN re-simulates at most this many ticks
+  static constexpr uint64_t KEYFRAME_INTERVAL = 10 * 20;  // ticks
+  // past then, keyframes are thinned to one per SPARSE_INTERVAL - or more
+  // widely spaced still, to keep no more than MAX_KEYFRAMES in all
+  static constexpr uint64_t RECENT_SPAN = 5 * 60 * 20;  // ticks
+  static constexpr uint64_t SPARSE_INTERVAL = 60 * 20;  // ticks
+  static constexpr size_t MAX_KEYFRAMES = 64;
+  static_assert(RECENT_SPAN / KEYFRAME_INTERVAL + 2 < MAX_KEYFRAMES,
+                "the recent keyframes must leave room for older ones");
+
+ private:
+  struct Keyframe final {
+    uint64_t tick;
+    // immutable once encoded, so the replay writer can share it
+    std::shared_ptr<std::vector<std::byte> const> save;
+  };
+
+  std::vector<Command> commands;
+  std::vector<Keyframe> keyframes;
+  uint64_t sparseInterval;  // between keyframes older than RECENT_SPAN
+
+  // the keyframe being encoded - only touched by its job while it's running
+  SaveImage image;
+  Keyframe encoded;
+  util::JobSystem::Handle encoding;
+
+  util::JobSystem::Handle writing;
+
+  // waits for the keyframe being encoded, and adds it to keyframes
+  void finishKeyframe() noexcept;
+  // drops old keyframes, so memory and the replay's size stay bounded
+  void thin() noexcept;
+};
+
+// a recorded game, re-simulated on demand
+class Replay final {
+ public:
+  // throws LoadException if the file can't be read or isn't a valid replay
+  explicit Replay(std::filesystem::path const &filename);
+  Replay(Replay const &) noexcept = delete;
+  Replay(Replay &&) noexcept = delete;
+
+  ~Replay() noexcept = default;
+
+  Replay &operator=(Replay const &) noexcept = delete;
+  Replay &operator=(Replay &&) noexcept = delete;
+
+  uint64_t getStartTick() const noexcept;
+  uint64_t getEndTick() const noexcept;
+  std::span<Command const> getCommands() const noexcept;
+  // ticks since the game started, as of world
+  uint64_t getTicks() const noexcept;
+
+  // brings world to where it was once tick ticks had passed, and that tick's
+  // commands were applied - re-simulating onwards from the current tick or
+  // the last keyframe before then, whichever is quicker; throws LoadException
+  // if that keyframe can't be read
+  void seek(uint64_t tick);
+
+  // empty until the first seek
+  World world;
+  SpatialIndex spatialIndex;
+
+ private:
+  std::filesystem::path filename;
+  std::vector<std::byte> data;
+  ReplayHeader header;
+  std::span<ReplayKeyframe const> keyframes;
+  std::span<Command const> commands;
+
+  uint64_t ticks;
+  size_t nextCommand;  // the first command not yet applied to world
+  bool loaded;
+};
+}  // namespace carrier_conquest::game
+
+#endif  // CARRIERCONQUEST_GAME_REPLAY_H_
@@ -0,0 +1,433 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "game/saveFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+#include <vector>
+
+#include "game/thumbnail.h"
+#include "util/exceptions/loadException.h"
+#include "util/jobSystem.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace std::filesystem;
+using namespace carrier_conquest::util::exceptions;
+
+namespace carrier_conquest::game {
+namespace {
+uint64_t alignUp(uint64_t offset) noexcept {
+  return (offset + SAVE_ALIGNMENT - 1) / SAVE_ALIGNMENT * SAVE_ALIGNMENT;
+}
+
+uint32_t crc(uint32_t crc, span<std::byte const> bytes) noexcept {
+  // zlib treats a null buffer as a request for the initial value
+  if (bytes.empty()) return crc;
+  return static_cast<uint32_t>(
+      crc32_z(crc, reinterpret_cast<Bytef const *>(bytes.data()),
+              bytes.size()));
+}
+
+// copies a section's entities or entries, then, for components, padding and
+// the components themselves
+void capture(SaveImage::Section &out, SaveSectionId id, uint32_t elementSize,
+             uint64_t count, span<std::byte const> head,
+             span<std::byte const> tail) noexcept {
+  uint64_t tailOffset = tail.empty() ? head.size() : alignUp(head.size());
+  out.section = SaveSection{
+      id, elementSize, 0, SaveEncoding::RAW, count, 0, tailOffset + tail.size(),
+      0};
+  out.bytes.resize(out.section.size);
+  if (!head.empty()) memcpy(out.bytes.data(), head.data(), head.size());
+  fill(out.bytes.begin() + static_cast<ptrdiff_t>(head.size()),
+       out.bytes.begin() + static_cast<ptrdiff_t>(tailOffset), std::byte{0});
+  if (!tail.empty())
+    memcpy(out.bytes.data() + tailOffset, tail.data(), tail.size());
+}
+
+// deflates a section, unless that wouldn't make it any smaller
+void compress(SaveImage::Section &section) noexcept {
+  span<std::byte const> stored = section.bytes;
+  section.section.encoding = SaveEncoding::RAW;
+  if (!section.bytes.empty()) {
+    uLongf length = compressBound(section.bytes.size());
+    section.stored.resize(length);
+    if (compress2(reinterpret_cast<Bytef *>(section.stored.data()), &length,
+                  reinterpret_cast<Bytef const *>(section.bytes.data()),
+                  section.bytes.size(), Z_BEST_SPEED) == Z_OK &&
+        length < section.bytes.size()) {
+      section.stored.resize(length);
+      section.section.encoding = SaveEncoding::ZLIB;
+      stored = section.stored;
+    }
+  }
+  section.section.storedSize = stored.size();
+  section.section.checksum = crc(0, stored);
+}
+
+[[noreturn]] void failed(string const &what) {
+  throw system_error(errno, generic_category(), what);
+}
+
+void writeAll(int fd, span<std::byte const> bytes) {
+  while (!bytes.empty()) {
+    ssize_t written = ::write(fd, bytes.data(), bytes.size());
+    if (written == -1) {
+      if (errno == EINTR) continue;
+      failed("could not write file");
+    }
+    bytes = bytes.subspan(static_cast<size_t>(written));
+  }
+}
+
+[[noreturn]] void invalid(path const &filename, string const &why) {
+  throw LoadException("Could not read save file", filename.string() + why);
+}
+
+// checks a header against the size of the file it came from
+void checkHeader(path const &filename, SaveHeader const &header,
+                 uint64_t size) {
+  if (memcmp(header.magic, SAVE_MAGIC, sizeof(SAVE_MAGIC)) != 0)
+    invalid(filename, " is not a save file");
+  if (header.version != SAVE_VERSION)
+    invalid(filename, " is from an incompatible version of the game");
+  if (header.sectionCount > (size - sizeof(SaveHeader)) / sizeof(SaveSection))
+    invalid(filename, " is truncated");
+}
+
+void checkTable(path const &filename, SaveHeader const &header,
+                span<SaveSection const> table) {
+  SaveHeader unsummed = header;
+  unsummed.checksum = 0;
+  if (crc(crc(0, as_bytes(span(&unsummed, 1))), as_bytes(table)) !=
+      header.checksum)
+    invalid(filename, " is corrupted");
+}
+}  // namespace
+
+void captureSave(World const &world, SaveInfo const &info,
+                 SaveImage &image) noexcept {
+  image.summary = SaveSummary{};
+  info.name.copy(image.summary.name, SAVE_NAME_SIZE - 1);
+  image.summary.savedAt =
+      duration_cast<seconds>(system_clock::now().time_since_epoch()).count();
+  image.summary.ticks = info.ticks;
+  image.summary.seed = info.seed;
+  image.summary.difficulty = info.difficulty;
+  image.summary.hasThumbnail = 1;
+  drawThumbnail(world, image.summary.thumbnail);
+
+  image.sections.resize(2 + tuple_size_v<SaveSchema>);
+  auto out = image.sections.begin();
+  EntityAllocator const &allocator = world.getAllocator();
+  capture(*out++, SaveSectionId::GENERATIONS, sizeof(uint32_t),
+          allocator.getGenerations().size(),
+          as_bytes(allocator.getGenerations()), {});
+  capture(*out++, SaveSectionId::FREE_INDICES, sizeof(uint32_t),
+          allocator.getFreeIndices().size(),
+          as_bytes(allocator.getFreeIndices()), {});
+  apply(
+      [&](auto... saved) {
+        (
+            [&]<typename Saved>(Saved) {
+              using T = typename Saved::Component;
+              ComponentStore<T> const &store = world.store<T>();
+              span<std::byte const> components;
+              if constexpr (savedSize<T>() != 0)
+                components = as_bytes(store.getComponents());
+              capture(*out++, Saved::SECTION, savedSize<T>(), store.size(),
+                      as_bytes(store.getEntities()), components);
+            }(saved),
+            ...);
+      },
+      SaveSchema{});
+}
+
+void encodeSave(SaveImage &image, vector<std::byte> &out) noexcept {
+  util::jobs->parallelFor(image.sections.size(), 1,
+                          [&](size_t begin, size_t end) {
+                            for (size_t index = begin; index < end; ++index)
+                              compress(image.sections[index]);
+                          });
+
+  vector<SaveSection> table;
+  uint64_t offset =
+      alignUp(sizeof(SaveHeader) + image.sections.size() * sizeof(SaveSection));
+  for (SaveImage::Section &section : image.sections) {
+    section.section.offset = offset;
+    offset = alignUp(offset + section.section.storedSize);
+    table.push_back(section.section);
+  }
+
+  SaveHeader header{};
+  memcpy(header.magic, SAVE_MAGIC, sizeof(SAVE_MAGIC));
+  header.version = SAVE_VERSION;
+  header.sectionCount = static_cast<uint32_t>(table.size());
+  header.summary = image.summary;
+  header.checksum =
+      crc(crc(0, as_bytes(span(&header, 1))), as_bytes(span(table)));
+
+  // padding is zeroed by assign
+  out.assign(offset, std::byte{0});
+  memcpy(out.data(), &header, sizeof(SaveHeader));
+  memcpy(out.data() + sizeof(SaveHeader), table.data(),
+         table.size() * sizeof(SaveSection));
+  for (SaveImage::Section const &section : image.sections) {
+    span<std::byte const> stored =
+        section.section.encoding == SaveEncoding::ZLIB
+            ? span<std::byte const>(section.stored)
+            : span<std::byte const>(section.bytes);
+    if (!stored.empty())
+      memcpy(out.data() + section.section.offset, stored.data(),
+             stored.size());
+  }
+}
+
+void writeAtomically(path const &filename, span<std::byte const> bytes) {
+  path temporary = filename;
+  temporary += ".tmp";
+  int fd = open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                0644);
+  if (fd == -1) failed("could not create " + filename.filename().string());
+  try {
+    writeAll(fd, bytes);
+    // the data must be on disk before the rename is, or a crash could leave
+    // the new name pointing at an empty file
+    if (fsync(fd) != 0) failed("could not sync " + temporary.string());
+  } catch (...) {
+    close(fd);
+    unlink(temporary.c_str());
+    throw;
+  }
+  if (close(fd) != 0) failed("could not write " + temporary.string());
+
+  if (::rename(temporary.c_str(), filename.c_str()) != 0)
+    failed("could not replace " + filename.string());
+  path directory = filename.parent_path();
+  int dirFd = open(directory.empty() ? "." : directory.c_str(),
+                   O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (dirFd == -1) failed("could not sync " + directory.string());
+  int synced = fsync(dirFd);
+  close(dirFd);
+  if (synced != 0) failed("could not sync " + directory.string());
+}
+
+void writeSave(path const &filename, SaveImage &image) {
+  vector<std::byte> bytes;
+  encodeSave(image, bytes);
+  writeAtomically(filename, bytes);
+}
+
+SaveSummary readSaveSummary(path const &filename) {
+  ifstream fin(filename, ios_base::in | ios_base::binary);
+  error_code error;
+  uint64_t size = file_size(filename, error);
+  if (!fin || error) invalid(filename, " could not be opened");
+
+  SaveHeader header;
+  if (size < sizeof(SaveHeader) ||
+      !fin.read(reinterpret_cast<char *>(&header), sizeof(SaveHeader)))
+    invalid(filename, " is truncated");
+  checkHeader(filename, header, size);
+  vector<SaveSection> table(header.sectionCount);
+  if (!fin.read(reinterpret_cast<char *>(table.data()),
+                static_cast<streamsize>(table.size() * sizeof(SaveSection))))
+    invalid(filename, " is truncated");
+  checkTable(filename, header, table);
+  return header.summary;
+}
+
+SaveFile::SaveFile(path const &filename)
+    : data(nullptr), size(0), mapped(false), header(), sections() {
+  int fd = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd == -1) invalid(filename, " could not be opened");
+
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    invalid(filename, " could not be opened");
+  }
+  size = static_cast<size_t>(info.st_size);
+
+  void *mapping = size == 0
+                      ? MAP_FAILED
+                      : mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);  // the mapping keeps the file alive
+  if (mapping == MAP_FAILED) invalid(filename, " could not be mapped");
+  data = static_cast<std::byte const *>(mapping);
+  mapped = true;
+  // read front to back, once
+  madvise(mapping, size, MADV_SEQUENTIAL);
+
+  try {
+    validate(filename);
+  } catch (...) {
+    munmap(mapping, size);
+    throw;
+  }
+}
+
+SaveFile::SaveFile(span<std::byte const> bytes, path const &name)
+    : data(bytes.data()),
+      size(bytes.size()),
+      mapped(false),
+      header(),
+      sections() {
+  validate(name);
+}
+
+SaveFile::~SaveFile() noexcept {
+  if (mapped) munmap(const_cast<std::byte *>(data), size);
+}
+
+SaveInfo SaveFile::getInfo() const noexcept {
+  return SaveInfo{
+      string(header.summary.name, strnlen(header.summary.name, SAVE_NAME_SIZE)),
+      header.summary.ticks, header.summary.seed, header.summary.difficulty};
+}
+
+SaveSummary const &SaveFile::getSummary() const noexcept {
+  return header.summary;
+}
+
+void SaveFile::read(World &world) const {
+  auto bad = []() {
+    throw LoadException("Could not read save file",
+                        "The save file is inconsistent");
+  };
+
+  // a section's bytes, inflated into buffer if they're compressed
+  auto contents = [&](SaveSection const *section,
+                      vector<std::byte> &buffer) -> std::byte const * {
+    if (section == nullptr || section->encoding == SaveEncoding::RAW)
+      return section == nullptr ? nullptr : data + section->offset;
+    // deflate can't do better than about 1032:1
+    if (section->size / 1032 > section->storedSize) bad();
+    buffer.resize(section->size);
+    uLongf length = section->size;
+    if (uncompress(reinterpret_cast<Bytef *>(buffer.data()), &length,
+                   reinterpret_cast<Bytef const *>(data + section->offset),
+                   section->storedSize) != Z_OK ||
+        length != section->size)
+      bad();
+    return buffer.data();
+  };
+
+  // an array of count elements at offset within a section, if it fits
+  auto array = [&]<typename T>(SaveSection const *section,
+                               std::byte const *bytes, uint64_t offset,
+                               T const *) -> span<T const> {
+    if (section == nullptr) return {};
+    if (section->count > (section->size - min(offset, section->size)) /
+                             max(sizeof(T), size_t{1}))
+      bad();
+    return span<T const>(reinterpret_cast<T const *>(bytes + offset),
+                         section->count);
+  };
+
+  SaveSection const *generations = find(SaveSectionId::GENERATIONS);
+  SaveSection const *freeIndices = find(SaveSectionId::FREE_INDICES);
+  if (generations == nullptr || generations->elementSize != sizeof(uint32_t) ||
+      (freeIndices != nullptr && freeIndices->elementSize != sizeof(uint32_t)))
+    bad();
+  vector<std::byte> generationBuffer;
+  vector<std::byte> freeBuffer;
+  span<uint32_t const> freeList =
+      array(freeIndices, contents(freeIndices, freeBuffer), 0,
+            static_cast<uint32_t const *>(nullptr));
+  for (uint32_t index : freeList)
+    if (index >= generations->count) bad();
+  world.getAllocator().restore(
+      array(generations, contents(generations, generationBuffer), 0,
+            static_cast<uint32_t const *>(nullptr)),
+      freeList);
+
+  vector<std::byte> buffer;
+  vector<bool> seen;
+  apply(
+      [&](auto... saved) {
+        (
+            [&]<typename Saved>(Saved) {
+              using T = typename Saved::Component;
+              SaveSection const *section = find(Saved::SECTION);
+              if (section == nullptr) return;
+              if (section->elementSize != savedSize<T>()) bad();
+
+              std::byte const *bytes = contents(section, buffer);
+              span<Entity const> entities = array(
+                  section, bytes, 0, static_cast<Entity const *>(nullptr));
+              seen.assign(generations->count, false);
+              for (Entity entity : entities) {
+                if (!world.alive(entity) || seen[entity.index]) bad();
+                seen[entity.index] = true;
+              }
+
+              span<T const> components;
+              if constexpr (savedSize<T>() != 0)
+                components = array(section, bytes,
+                                   alignUp(section->count * sizeof(Entity)),
+                                   static_cast<T const *>(nullptr));
+              world.store<T>().assign(entities, components);
+            }(saved),
+            ...);
+      },
+      SaveSchema{});
+}
+
+// sections this version doesn't know of are never looked for, so skipped
+void SaveFile::validate(path const &filename) {
+  if (size < sizeof(SaveHeader)) invalid(filename, " is truncated");
+  memcpy(&header, data, sizeof(SaveHeader));
+  checkHeader(filename, header, size);
+  sections = span<SaveSection const>(
+      reinterpret_cast<SaveSection const *>(data + sizeof(SaveHeader)),
+      header.sectionCount);
+  checkTable(filename, header, sections);
+
+  for (SaveSection const &section : sections) {
+    if (section.offset > size || section.storedSize > size - section.offset)
+      invalid(filename, " is truncated");
+    if (crc(0, span(data + section.offset, section.storedSize)) !=
+        section.checksum)
+      invalid(filename, " is corrupted");
+    if (section.encoding != SaveEncoding::ZLIB &&
+        (section.encoding != SaveEncoding::RAW ||
+         section.storedSize != section.size))
+      invalid(filename, " is corrupted");
+  }
+}
+
+SaveSection const *SaveFile::find(SaveSectionId id) const noexcept {
+  for (SaveSection const &section : sections)
+    if (section.id == id) return &section;
+  return nullptr;
+}
+}  // namespace carrier_conquest::game
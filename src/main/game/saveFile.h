@@ -0,0 +1,115 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_GAME_SAVEFILE_H_
+#define CARRIERCONQUEST_GAME_SAVEFILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "game/saveFormat.h"
+#include "game/world.h"
+
+namespace carrier_conquest::game {
+// everything saved besides the world
+struct SaveInfo final {
+  std::string name;  // truncated to fit in SAVE_NAME_SIZE, if need be
+  uint64_t ticks;
+  uint64_t seed;
+  uint32_t difficulty;
+};
+
+// a world's state, copied out for saving
+struct SaveImage final {
+  struct Section final {
+    SaveSection section;
+    std::vector<std::byte> bytes;   // as laid out once inflated
+    std::vector<std::byte> stored;  // deflated, unless stored raw
+  };
+
+  SaveSummary summary;
+  std::vector<Section> sections;
+};
+
+// copies world into image, reusing its buffers, and draws its thumbnail -
+// only a bulk copy of each component array, so cheap enough to take between
+// ticks
+void captureSave(World const &world, SaveInfo const &info,
+                 SaveImage &image) noexcept;
+
+// compresses image's sections in parallel, and lays them out as a save file
+// in out
+void encodeSave(SaveImage &image, std::vector<std::byte> &out) noexcept;
+
+// writes bytes to a temporary file that's synced and renamed over filename,
+// so neither a failed write nor a crash leaves a truncated file behind -
+// throws std::system_error if it can't
+void writeAtomically(std::filesystem::path const &filename,
+                     std::span<std::byte const> bytes);
+
+// encodes image, then writes it atomically
+void writeSave(std::filesystem::path const &filename, SaveImage &image);
+
+// the summary in a save's header, after checking the header and section
+// table, but not the rest of the file - throws LoadException if the file
+// can't be read or isn't a valid save
+SaveSummary readSaveSummary(std::filesystem::path const &filename);
+
+// a save, mapped into memory and checked against its checksums
+class SaveFile final {
+ public:
+  // throws LoadException if the file can't be read or isn't a valid save
+  explicit SaveFile(std::filesystem::path const &filename);
+  // a save that's already in memory, and outlives this; name is only used in
+  // errors
+  SaveFile(std::span<std::byte const> bytes,
+           std::filesystem::path const &name);
+  SaveFile(SaveFile const &) noexcept = delete;
+  SaveFile(SaveFile &&) noexcept = delete;
+
+  ~SaveFile() noexcept;
+
+  SaveFile &operator=(SaveFile const &) noexcept = delete;
+  SaveFile &operator=(SaveFile &&) noexcept = delete;
+
+  SaveInfo getInfo() const noexcept;
+  SaveSummary const &getSummary() const noexcept;
+  // fills an empty world, copying each section straight from the mapping -
+  // or, if it's compressed, from where it's inflated to - into its component
+  // store; throws LoadException if they don't fit
+  void read(World &world) const;
+
+ private:
+  std::byte const *data;
+  size_t size;
+  bool mapped;  // by this, rather than borrowed
+  SaveHeader header;
+  std::span<SaveSection const> sections;
+
+  // reads the header and section table, and checks every section
+  void validate(std::filesystem::path const &filename);
+  SaveSection const *find(SaveSectionId id) const noexcept;
+};
+}  // namespace carrier_conquest::game
+
+#endif  // CARRIERCONQUEST_GAME_SAVEFILE_H_
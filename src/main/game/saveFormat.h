@@ -0,0 +1,195 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_GAME_SAVEFORMAT_H_
+#define CARRIERCONQUEST_GAME_SAVEFORMAT_H_
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+
+#include "game/components.h"
+#include "game/entity.h"
+#include "util/cookedTexture.h"
+
+namespace carrier_conquest::game {
+constexpr size_t SAVE_NAME_SIZE = 64;
+constexpr uint32_t THUMBNAIL_SIZE = 64;  // pixels, square
+constexpr uint64_t THUMBNAIL_BYTES = util::levelSize(
+    util::TextureFormat::BC1, THUMBNAIL_SIZE, THUMBNAIL_SIZE);
+
+// everything needed to list a save - fixed size, so a save can be listed
+// from its header alone
+struct SaveSummary final {
+  char name[SAVE_NAME_SIZE];  // UTF-8, zero-padded
+  int64_t savedAt;            // seconds since the Unix epoch
+  uint64_t ticks;
+  uint64_t seed;
+  uint32_t difficulty;
+  uint32_t hasThumbnail;
+  // a map of the campaign as BC1 blocks, bottom row first
+  std::byte thumbnail[THUMBNAIL_BYTES];
+};
+
+// on-disk layout - a header, then a section table, then the data of each
+// section, each aligned to SAVE_ALIGNMENT
+// a component section holds its entities, then (aligned) the components, in
+// their in-memory layout; tag components have no component array
+// a section may be stored zlib-compressed, in which case size is its size
+// once inflated
+// checksums are CRC-32s - the header's covers the header, with its checksum
+// zeroed, and the section table; each section's covers its stored bytes
+// all fields are little-endian
+struct SaveHeader final {
+  char magic[4];
+  uint32_t version;
+  uint32_t checksum;
+  uint32_t sectionCount;
+  SaveSummary summary;
+};
+
+enum class SaveSectionId : uint32_t {
+  GENERATIONS,   // uint32_t per entity index ever handed out
+  FREE_INDICES,  // uint32_t per index awaiting reuse
+  POSITION,
+  PREVIOUS_POSITION,
+  VELOCITY,
+  ALLEGIANCE,
+  HULL,
+  SHIP,
+  CARRIER,
+  SQUADRON,
+  PROJECTILE,
+  FLEET,
+  SECTOR,
+  STAR_SYSTEM,
+  SPOTTED,
+};
+
+enum class SaveEncoding : uint32_t {
+  RAW,
+  ZLIB,
+};
+
+struct SaveSection final {
+  SaveSectionId id;
+  uint32_t elementSize;  // bytes per component, or per entry
+  uint32_t checksum;
+  SaveEncoding encoding;
+  uint64_t count;
+  uint64_t offset;
+  uint64_t size;        // bytes
+  uint64_t storedSize;  // bytes in the file
+};
+
+constexpr char SAVE_MAGIC[4] = {'C', 'C', 'S', 'V'};
+// bump whenever a saved component's layout or the schema changes
+constexpr uint32_t SAVE_VERSION = 3;
+constexpr uint64_t SAVE_ALIGNMENT = 16;
+
+// the save index caches the summary of every save in a directory, so the
+// load screen needn't open each one - a header, then an entry per save
+// an entry is current if its save's size and modification time still match
+// the checksum is a CRC-32 over the whole file, with the checksum zeroed
+struct SaveIndexHeader final {
+  char magic[4];
+  uint32_t version;
+  uint32_t checksum;
+  uint32_t count;
+};
+
+struct SaveIndexEntry final {
+  char filename[128];  // within the directory, zero-padded
+  int64_t modified;    // in the filesystem clock's ticks
+  uint64_t size;       // bytes
+  SaveSummary summary;
+};
+
+constexpr char SAVE_INDEX_MAGIC[4] = {'C', 'C', 'S', 'I'};
+constexpr uint32_t SAVE_INDEX_VERSION = 1;
+constexpr char const *SAVE_INDEX_NAME = "saves.ccindex";
+constexpr char const *SAVE_EXTENSION = ".ccsave";
+
+// a replay is the commands issued over a game, plus keyframes - saves of the
+// world every so often - to start re-simulating from - a header, then a
+// keyframe table, then the commands, then each keyframe's save, aligned to
+// SAVE_ALIGNMENT
+// the checksum is a CRC-32 over the header, with the checksum zeroed, the
+// keyframe table, and the commands; each keyframe checks itself
+struct ReplayHeader final {
+  char magic[4];
+  uint32_t version;
+  uint32_t checksum;
+  uint32_t keyframeCount;
+  uint64_t commandCount;
+  uint64_t startTick;  // of the first keyframe
+  uint64_t endTick;    // when recording stopped
+};
+
+struct ReplayKeyframe final {
+  uint64_t tick;
+  uint64_t offset;
+  uint64_t size;  // bytes
+};
+
+constexpr char REPLAY_MAGIC[4] = {'C', 'C', 'R', 'P'};
+// bump whenever Command's layout or the simulation's results change -
+// keyframes are versioned as saves
+constexpr uint32_t REPLAY_VERSION = 3;
+constexpr char const *REPLAY_EXTENSION = ".ccreplay";
+
+static_assert(std::endian::native == std::endian::little,
+              "saves are only readable on little-endian hosts");
+
+// the schema - every saved component and the section it goes in
+// Selected isn't saved; it's UI state
+template <typename T, SaveSectionId ID>
+struct SavedComponent final {
+  using Component = T;
+  static constexpr SaveSectionId SECTION = ID;
+
+  static_assert(std::is_trivially_copyable_v<T>,
+                "saved components are written as raw bytes");
+};
+
+using SaveSchema = std::tuple<
+    SavedComponent<Position, SaveSectionId::POSITION>,
+    SavedComponent<PreviousPosition, SaveSectionId::PREVIOUS_POSITION>,
+    SavedComponent<Velocity, SaveSectionId::VELOCITY>,
+    SavedComponent<Allegiance, SaveSectionId::ALLEGIANCE>,
+    SavedComponent<Hull, SaveSectionId::HULL>,
+    SavedComponent<Ship, SaveSectionId::SHIP>,
+    SavedComponent<Carrier, SaveSectionId::CARRIER>,
+    SavedComponent<Squadron, SaveSectionId::SQUADRON>,
+    SavedComponent<Projectile, SaveSectionId::PROJECTILE>,
+    SavedComponent<Fleet, SaveSectionId::FLEET>,
+    SavedComponent<Sector, SaveSectionId::SECTOR>,
+    SavedComponent<StarSystem, SaveSectionId::STAR_SYSTEM>,
+    SavedComponent<Spotted, SaveSectionId::SPOTTED>>;
+
+// bytes of a component as saved - zero for tags
+template <typename T>
+constexpr uint32_t savedSize() noexcept {
+  return std::is_empty_v<T> ? 0 : static_cast<uint32_t>(sizeof(T));
+}
+}  // namespace carrier_conquest::game
+
+#endif  // CARRIERCONQUEST_GAME_SAVEFORMAT_H_
@@ -0,0 +1,160 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "game/saveIndex.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+
+#include "game/saveFile.h"
+#include "util/exceptions/loadException.h"
+
+using namespace std;
+using namespace std::filesystem;
+using namespace carrier_conquest::util::exceptions;
+
+namespace carrier_conquest::game {
+namespace {
+uint32_t checksum(SaveIndexHeader header,
+                  vector<SaveIndexEntry> const &entries) noexcept {
+  header.checksum = 0;
+  uLong crc = crc32_z(0, reinterpret_cast<Bytef const *>(&header),
+                      sizeof(header));
+  if (!entries.empty())
+    crc = crc32_z(crc, reinterpret_cast<Bytef const *>(entries.data()),
+                  entries.size() * sizeof(SaveIndexEntry));
+  return static_cast<uint32_t>(crc);
+}
+
+// an unreadable index is as good as an empty one
+vector<SaveIndexEntry> readIndex(path const &filename) noexcept {
+  ifstream fin(filename, ios_base::in | ios_base::binary);
+  error_code error;
+  uint64_t size = file_size(filename, error);
+  SaveIndexHeader header;
+  if (!fin || error || size < sizeof(header) ||
+      !fin.read(reinterpret_cast<char *>(&header), sizeof(header)))
+    return {};
+  if (memcmp(header.magic, SAVE_INDEX_MAGIC, sizeof(SAVE_INDEX_MAGIC)) != 0 ||
+      header.version != SAVE_INDEX_VERSION ||
+      header.count != (size - sizeof(header)) / sizeof(SaveIndexEntry))
+    return {};
+
+  vector<SaveIndexEntry> entries(header.count);
+  if (!fin.read(reinterpret_cast<char *>(entries.data()),
+                static_cast<streamsize>(entries.size() *
+                                        sizeof(SaveIndexEntry))) ||
+      checksum(header, entries) != header.checksum)
+    return {};
+  return entries;
+}
+
+// through a temporary file, like a save - if it can't be written, the next
+// listing just reads the headers again
+void writeIndex(path const &filename,
+                vector<SaveIndexEntry> const &entries) noexcept {
+  SaveIndexHeader header{};
+  memcpy(header.magic, SAVE_INDEX_MAGIC, sizeof(SAVE_INDEX_MAGIC));
+  header.version = SAVE_INDEX_VERSION;
+  header.count = static_cast<uint32_t>(entries.size());
+  header.checksum = checksum(header, entries);
+
+  path temporary = filename;
+  temporary += ".tmp";
+  {
+    ofstream fout(temporary,
+                  ios_base::out | ios_base::binary | ios_base::trunc);
+    fout.write(reinterpret_cast<char const *>(&header), sizeof(header));
+    fout.write(reinterpret_cast<char const *>(entries.data()),
+               static_cast<streamsize>(entries.size() *
+                                       sizeof(SaveIndexEntry)));
+    if (!fout) return;
+  }
+  error_code error;
+  rename(temporary, filename, error);
+}
+}  // namespace
+
+vector<SaveListing> listSaves(path const &directory) noexcept {
+  path indexName = directory / SAVE_INDEX_NAME;
+  unordered_map<string, SaveIndexEntry> indexed;
+  for (SaveIndexEntry const &entry : readIndex(indexName))
+    indexed.emplace(string(entry.filename,
+                           strnlen(entry.filename, sizeof(entry.filename))),
+                    entry);
+
+  vector<SaveListing> listings;
+  vector<SaveIndexEntry> entries;
+  bool changed = false;
+  error_code error;
+  for (directory_iterator it(directory, error), end; !error && it != end;
+       it.increment(error)) {
+    directory_entry const &file = *it;
+    error_code fileError;
+    if (file.path().extension() != SAVE_EXTENSION ||
+        !file.is_regular_file(fileError))
+      continue;
+
+    SaveIndexEntry entry{};
+    string name = file.path().filename().string();
+    bool indexable = name.size() < sizeof(entry.filename);
+    entry.size = file.file_size(fileError);
+    if (fileError) continue;
+    entry.modified = file.last_write_time(fileError).time_since_epoch().count();
+    if (fileError) continue;
+
+    auto found = indexed.find(name);
+    if (found != indexed.end() && found->second.size == entry.size &&
+        found->second.modified == entry.modified) {
+      entry.summary = found->second.summary;
+      indexed.erase(found);
+    } else {
+      try {
+        entry.summary = readSaveSummary(file.path());
+      } catch (LoadException const &) {
+        continue;  // not listed, and not indexed, so checked again next time
+      }
+      changed = changed || indexable;
+    }
+
+    listings.push_back(SaveListing{file.path(), entry.summary});
+    if (indexable) {
+      name.copy(entry.filename, sizeof(entry.filename) - 1);
+      entries.push_back(entry);
+    }
+  }
+  // entries for saves that are gone
+  if (!indexed.empty()) changed = true;
+  if (changed) writeIndex(indexName, entries);
+
+  sort(listings.begin(), listings.end(),
+       [](SaveListing const &a, SaveListing const &b) {
+         if (a.summary.savedAt != b.summary.savedAt)
+           return a.summary.savedAt > b.summary.savedAt;
+         return a.filename < b.filename;
+       });
+  return listings;
+}
+}  // namespace carrier_conquest::game
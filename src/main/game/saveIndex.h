@@ -0,0 +1,41 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_GAME_SAVEINDEX_H_
+#define CARRIERCONQUEST_GAME_SAVEINDEX_H_
+
+#include <filesystem>
+#include <vector>
+
+#include "game/saveFormat.h"
+
+namespace carrier_conquest::game {
+struct SaveListing final {
+  std::filesystem::path filename;
+  SaveSummary summary;
+};
+
+// the valid saves in directory, newest first - each summary comes from the
+// directory's index if its entry is current, else from the save's header,
+// after which the index is rewritten
+std::vector<SaveListing> listSaves(
+    std::filesystem::path const &directory) noexcept;
+}  // namespace carrier_conquest::game
+
+#endif  // CARRIERCONQUEST_GAME_SAVEINDEX_H_
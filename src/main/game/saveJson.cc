@@ -0,0 +1,145 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "game/saveJson.h"
+
+#include <fstream>
+#include <iomanip>
+#include <nlohmann/json.hpp>
+
+using namespace std;
+using namespace std::filesystem;
+using namespace nlohmann;
+
+namespace carrier_conquest::game {
+namespace {
+json entity(Entity entity) {
+  return json::array({entity.index, entity.generation});
+}
+
+json fields(Position const &c) { return {{"x", c.x}, {"y", c.y}}; }
+json fields(PreviousPosition const &c) { return {{"x", c.x}, {"y", c.y}}; }
+json fields(Velocity const &c) { return {{"x", c.x}, {"y", c.y}}; }
+json fields(Allegiance const &c) {
+  return {{"side", c.side == Side::PLAYER ? "player" : "enemy"}};
+}
+json fields(Hull const &c) {
+  return {{"integrity", c.integrity}, {"maxIntegrity", c.maxIntegrity}};
+}
+json fields(Ship const &c) { return {{"fleet", entity(c.fleet)}}; }
+json fields(Carrier const &c) {
+  return {{"hangarCapacity", c.hangarCapacity}, {"aircraft", c.aircraft}};
+}
+json fields(Squadron const &c) {
+  return {{"carrier", entity(c.carrier)},
+          {"aircraft", c.aircraft},
+          {"fuel", c.fuel}};
+}
+json fields(Projectile const &c) {
+  return {{"target", entity(c.target)},
+          {"damage", c.damage},
+          {"lifetime", c.lifetime},
+          {"turnRate", c.turnRate}};
+}
+json fields(Fleet const &c) {
+  return {{"flagship", entity(c.flagship)}, {"ships", c.ships}};
+}
+json fields(Sector const &c) {
+  return {{"column", c.column}, {"row", c.row}};
+}
+json fields(StarSystem const &c) {
+  return {{"sector", entity(c.sector)},
+          {"industry", c.industry},
+          {"resources", c.resources}};
+}
+json fields(Spotted const &) { return json::object(); }
+
+char const *nameOf(SaveSectionId id) noexcept {
+  switch (id) {
+    case SaveSectionId::GENERATIONS:
+      return "generations";
+    case SaveSectionId::FREE_INDICES:
+      return "freeIndices";
+    case SaveSectionId::POSITION:
+      return "position";
+    case SaveSectionId::PREVIOUS_POSITION:
+      return "previousPosition";
+    case SaveSectionId::VELOCITY:
+      return "velocity";
+    case SaveSectionId::ALLEGIANCE:
+      return "allegiance";
+    case SaveSectionId::HULL:
+      return "hull";
+    case SaveSectionId::SHIP:
+      return "ship";
+    case SaveSectionId::CARRIER:
+      return "carrier";
+    case SaveSectionId::SQUADRON:
+      return "squadron";
+    case SaveSectionId::PROJECTILE:
+      return "projectile";
+    case SaveSectionId::FLEET:
+      return "fleet";
+    case SaveSectionId::SECTOR:
+      return "sector";
+    case SaveSectionId::STAR_SYSTEM:
+      return "starSystem";
+    case SaveSectionId::SPOTTED:
+      return "spotted";
+  }
+  return "unknown";
+}
+}  // namespace
+
+void exportJson(path const &filename, World const &world,
+                SaveInfo const &info) {
+  EntityAllocator const &allocator = world.getAllocator();
+  json j = {{"version", SAVE_VERSION},
+            {"name", info.name},
+            {"ticks", info.ticks},
+            {"seed", info.seed},
+            {"difficulty", info.difficulty},
+            {nameOf(SaveSectionId::GENERATIONS), allocator.getGenerations()},
+            {nameOf(SaveSectionId::FREE_INDICES), allocator.getFreeIndices()}};
+
+  json &components = j["components"];
+  apply(
+      [&](auto... saved) {
+        (
+            [&]<typename Saved>(Saved) {
+              using T = typename Saved::Component;
+              ComponentStore<T> const &store = world.store<T>();
+              json &array = components[nameOf(Saved::SECTION)];
+              array = json::array();
+              for (size_t index = 0; index < store.size(); ++index) {
+                json element = fields(store.getComponents()[index]);
+                element["entity"] = entity(store.getEntities()[index]);
+                array.push_back(move(element));
+              }
+            }(saved),
+            ...);
+      },
+      SaveSchema{});
+
+  ofstream fout;
+  fout.exceptions(ofstream::failbit | ofstream::badbit);
+  fout.open(filename, ios_base::out | ios_base::binary | ios_base::trunc);
+  fout << setw(2) << j;
+}
+}  // namespace carrier_conquest::game
@@ -0,0 +1,36 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_GAME_SAVEJSON_H_
+#define CARRIERCONQUEST_GAME_SAVEJSON_H_
+
+#include <filesystem>
+
+#include "game/saveFile.h"
+#include "game/world.h"
+
+namespace carrier_conquest::game {
+// writes everything a save holds as human-readable JSON, for debugging -
+// this is an export only; saves are always loaded from the binary format
+// throws std::ios_base::failure if it can't write the file
+void exportJson(std::filesystem::path const &filename, World const &world,
+                SaveInfo const &info);
+}  // namespace carrier_conquest::game
+
+#endif  // CARRIERCONQUEST_GAME_SAVEJSON_H_
@@ -0,0 +1,152 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "game/simulation.h"
+
+#include <cmath>
+
+#include "util/fixedTimestep.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace carrier_conquest::util;
+
+namespace carrier_conquest::game {
+Simulation::Simulation(GameState &state) noexcept
+    : state(state),
+      mutex(),
+      wake(),
+      paused(false),
+      commands(),
+      snapshots(),
+      thread([this](stop_token token) { run(token); }) {}
+
+void Simulation::setPaused(bool paused) noexcept {
+  {
+    lock_guard lock(mutex);
+    this->paused = paused;
+  }
+  wake.notify_one();
+}
+
+void Simulation::select(Entity entity) noexcept {
+  issue(Command{0, entity, 0.0f, 0.0f, CommandType::SELECT, 0});
+}
+
+void Simulation::issue(Command command) noexcept {
+  {
+    lock_guard lock(mutex);
+    commands.push_back(command);
+  }
+  wake.notify_one();
+}
+
+bool Simulation::update() noexcept { return snapshots.update(); }
+
+Snapshot const &Simulation::getSnapshot() const noexcept {
+  return snapshots.getFront();
+}
+
+void Simulation::run(stop_token const &token) noexcept {
+  FixedTimestep timestep(GameState::TICK_LENGTH);
+  steady_clock::time_point last = steady_clock::now();
+  // a snapshot's time is that of its tick, even if it's republished later
+  steady_clock::time_point tickTime = last;
+  publish(tickTime);
+
+  while (!token.stop_requested()) {
+    bool changed = false;
+    {
+      unique_lock lock(mutex);
+      // sleep until the next tick is due - or, while paused, until unpaused
+      auto commanded = [this]() { return !commands.empty(); };
+      if (paused) {
+        wake.wait(lock, token, [&]() { return !paused || commanded(); });
+        last = steady_clock::now();  // time spent paused doesn't count
+      } else {
+        wake.wait_until(
+            lock, token,
+            last + duration_cast<steady_clock::duration>(duration<double>(
+                       (1.0 - timestep.getAlpha()) * GameState::TICK_LENGTH)),
+            [&]() { return paused || commanded(); });
+      }
+
+      for (Command &command : commands) {
+        command.tick = state.getTicks();
+        state.issue(command);
+      }
+      changed = !commands.empty();
+      commands.clear();
+      if (paused) {
+        if (changed) publish(tickTime);
+        continue;
+      }
+    }
+
+    steady_clock::time_point now = steady_clock::now();
+    unsigned ticks =
+        timestep.advance(duration<double>(now - last).count());
+    last = now;
+    for (unsigned tick = 0; tick < ticks; ++tick) state.tick();
+    if (ticks != 0) tickTime = now;
+    if (ticks != 0 || changed) publish(tickTime);
+  }
+
+  // leaving the game saves it, while this thread still owns it
+  state.save();
+}
+
+void Simulation::publish(steady_clock::time_point tickTime) noexcept {
+  World &world = state.world;
+  Snapshot &snapshot = snapshots.getBack();
+  snapshot.tick = state.getTicks();
+  snapshot.time = tickTime;
+  snapshot.objects.clear();
+  Autosave const &autosave = state.getAutosave();
+  snapshot.saveFailures = autosave.getFailureCount();
+  snapshot.saveFailure = autosave.getFailure();
+  world.each<Position, Allegiance>([&](Entity entity, Position const &position,
+                                       Allegiance const &allegiance) {
+    Snapshot::Object object;
+    object.entity = entity;
+    object.x = object.previousX = position.x;
+    object.y = object.previousY = position.y;
+    object.headingX = 1.0f;
+    object.headingY = 0.0f;
+    object.side = allegiance.side;
+    object.visible =
+        allegiance.side == Side::PLAYER || world.has<Spotted>(entity);
+    object.selected = world.has<Selected>(entity);
+    if (PreviousPosition const *previous =
+            world.get<PreviousPosition>(entity)) {
+      object.previousX = previous->x;
+      object.previousY = previous->y;
+    }
+    if (Velocity const *velocity = world.get<Velocity>(entity)) {
+      float speed = hypot(velocity->x, velocity->y);
+      if (speed > 0.0f) {
+        object.headingX = velocity->x / speed;
+        object.headingY = velocity->y / speed;
+      }
+    }
+    snapshot.objects.push_back(object);
+  });
+  snapshots.publish();
+}
+}  // namespace carrier_conquest::game
@@ -0,0 +1,73 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_GAME_SIMULATION_H_
+#define CARRIERCONQUEST_GAME_SIMULATION_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "game/game.h"
+#include "game/snapshot.h"
+#include "util/tripleBuffer.h"
+
+namespace carrier_conquest::game {
+// runs a game's ticks on a thread of its own, publishing a snapshot after
+// each one - the game state belongs to that thread until this is destroyed
+class Simulation final {
+ public:
+  explicit Simulation(GameState &state) noexcept;
+  Simulation(Simulation const &) noexcept = delete;
+  Simulation(Simulation &&) noexcept = delete;
+
+  ~Simulation() noexcept = default;
+
+  Simulation &operator=(Simulation const &) noexcept = delete;
+  Simulation &operator=(Simulation &&) noexcept = delete;
+
+  void setPaused(bool paused) noexcept;
+  // selects a single entity, or nothing, given Entity::NONE
+  void select(Entity entity) noexcept;
+  // queues a command, to be issued before the next tick
+  void issue(Command command) noexcept;
+
+  // picks up the latest snapshot, if there's a newer one; returns true if so
+  bool update() noexcept;
+  Snapshot const &getSnapshot() const noexcept;
+
+ private:
+  GameState &state;
+
+  std::mutex mutex;
+  std::condition_variable_any wake;
+  bool paused;
+  std::vector<Command> commands;  // their ticks are filled in when issued
+
+  util::TripleBuffer<Snapshot> snapshots;
+  std::jthread thread;
+
+  void run(std::stop_token const &token) noexcept;
+  void publish(std::chrono::steady_clock::time_point tickTime) noexcept;
+};
+}  // namespace carrier_conquest::game
+
+#endif  // CARRIERCONQUEST_GAME_SIMULATION_H_
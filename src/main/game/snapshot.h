@@ -0,0 +1,57 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_GAME_SNAPSHOT_H_
+#define CARRIERCONQUEST_GAME_SNAPSHOT_H_
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "game/components.h"
+#include "game/entity.h"
+
+namespace carrier_conquest::game {
+// everything the renderer needs from one simulation tick
+struct Snapshot final {
+  struct Object final {
+    Entity entity;
+    float x;
+    float y;
+    float previousX;
+    float previousY;
+    float headingX;  // unit vector
+    float headingY;
+    Side side;
+    bool visible;
+    bool selected;
+  };
+
+  uint64_t tick;
+  std::chrono::steady_clock::time_point time;  // when the tick finished
+  std::vector<Object> objects;
+  // saves that couldn't be written so far, and why the latest one couldn't
+  uint32_t saveFailures;
+  std::optional<std::string> saveFailure;
+};
+}  // namespace carrier_conquest::game
+
+#endif  // CARRIERCONQUEST_GAME_SNAPSHOT_H_
@@ -0,0 +1,255 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "game/spatialIndex.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#include "game/detMath.h"
+#include "util/arena.h"
+#include "util/jobSystem.h"
+
+using namespace std;
+using namespace carrier_conquest::util;
+
+namespace carrier_conquest::game {
+namespace {
+// queries per job when answering a batch
+constexpr size_t QUERY_GRAIN = 64;
+}  // namespace
+
+SpatialIndex::SpatialIndex() noexcept
+    : xs(),
+      ys(),
+      entities(),
+      sides(),
+      bucketStarts(2, 0),
+      unitBuckets(),
+      bucketMask(0),
+      minCellX(0),
+      minCellY(0),
+      maxCellX(-1),
+      maxCellY(-1) {}
+
+void SpatialIndex::rebuild(World const &world) noexcept {
+  ComponentStore<Position> const &positions = world.store<Position>();
+  size_t count = positions.size();
+
+  // about two buckets per unit keeps collisions between cells rare
+  uint32_t buckets =
+      bit_ceil(max(static_cast<uint32_t>(count * 2), uint32_t{16}));
+  bucketMask = buckets - 1;
+  bucketStarts.assign(buckets + 1, 0);
+  unitBuckets.clear();
+  minCellX = minCellY = numeric_limits<int32_t>::max();
+  maxCellX = maxCellY = numeric_limits<int32_t>::min();
+
+  // count units per bucket
+  span<Entity const> owners = positions.getEntities();
+  span<Position const> components = positions.getComponents();
+  for (size_t index = 0; index < count; ++index) {
+    if (!world.has<Allegiance>(owners[index])) continue;
+    int32_t cellX = cellOf(components[index].x);
+    int32_t cellY = cellOf(components[index].y);
+    minCellX = min(minCellX, cellX);
+    minCellY = min(minCellY, cellY);
+    maxCellX = max(maxCellX, cellX);
+    maxCellY = max(maxCellY, cellY);
+    uint32_t bucket = bucketOf(cellX, cellY);
+    unitBuckets.push_back(bucket);
+    ++bucketStarts[bucket + 1];
+  }
+  for (uint32_t bucket = 0; bucket < buckets; ++bucket)
+    bucketStarts[bucket + 1] += bucketStarts[bucket];
+
+  // scatter units into place
+  size_t indexed = unitBuckets.size();
+  xs.resize(indexed);
+  ys.resize(indexed);
+  entities.resize(indexed);
+  sides.resize(indexed);
+  Arena::Scope scope(threadArena());
+  span<uint32_t> next = threadArena().allocate<uint32_t>(buckets);
+  copy(bucketStarts.begin(), bucketStarts.end() - 1, next.begin());
+  size_t unit = 0;
+  for (size_t index = 0; index < count; ++index) {
+    Allegiance const *allegiance = world.get<Allegiance>(owners[index]);
+    if (allegiance == nullptr) continue;
+    uint32_t slot = next[unitBuckets[unit++]]++;
+    xs[slot] = components[index].x;
+    ys[slot] = components[index].y;
+    entities[slot] = owners[index];
+    sides[slot] = allegiance->side;
+  }
+}
+
+void SpatialIndex::inRange(float x, float y, float radius,
+                           optional<Side> side,
+                           vector<Entity> &out) const noexcept {
+  float radiusSquared = radius * radius;
+  for (int32_t cellY = cellOf(y - radius); cellY <= cellOf(y + radius);
+       ++cellY) {
+    for (int32_t cellX = cellOf(x - radius); cellX <= cellOf(x + radius);
+         ++cellX) {
+      forEachInCell(cellX, cellY, side, [&](uint32_t unit) {
+        float dx = xs[unit] - x;
+        float dy = ys[unit] - y;
+        if (dx * dx + dy * dy <= radiusSquared) out.push_back(entities[unit]);
+      });
+    }
+  }
+}
+
+void SpatialIndex::inRange(span<RangeQuery const> queries,
+                           span<vector<Entity>> results) const noexcept {
+  jobs->parallelFor(queries.size(), QUERY_GRAIN, [&](size_t begin, size_t end) {
+    for (size_t index = begin; index < end; ++index) {
+      RangeQuery const &query = queries[index];
+      results[index].clear();
+      inRange(query.x, query.y, query.radius, query.side, results[index]);
+    }
+  });
+}
+
+void SpatialIndex::nearest(float x, float y, size_t k, optional<Side> side,
+                           vector<Hit> &out) const noexcept {
+  out.clear();
+  if (k == 0 || entities.empty()) return;
+
+  // max-heap on distance of the best k so far
+  auto further = [](Hit const &a, Hit const &b) {
+    return a.distance < b.distance;
+  };
+  auto consider = [&](uint32_t unit) {
+    float distance = length(xs[unit] - x, ys[unit] - y);
+    if (out.size() < k) {
+      out.push_back(Hit{entities[unit], distance});
+      push_heap(out.begin(), out.end(), further);
+    } else if (distance < out.front().distance) {
+      pop_heap(out.begin(), out.end(), further);
+      out.back() = Hit{entities[unit], distance};
+      push_heap(out.begin(), out.end(), further);
+    }
+  };
+
+  // walk square rings of cells outwards from the one containing (x, y);
+  // nothing in ring r + 1 is nearer than r whole cells
+  int32_t centreX = cellOf(x);
+  int32_t centreY = cellOf(y);
+  int32_t rings = max({centreX - minCellX, maxCellX - centreX,
+                       centreY - minCellY, maxCellY - centreY});
+  for (int32_t ring = 0; ring <= rings; ++ring) {
+    if (ring == 0) {
+      forEachInCell(centreX, centreY, side, consider);
+    } else {
+      for (int32_t offset = -ring; offset <= ring; ++offset) {
+        forEachInCell(centreX + offset, centreY - ring, side, consider);
+        forEachInCell(centreX + offset, centreY + ring, side, consider);
+      }
+      for (int32_t offset = -ring + 1; offset <= ring - 1; ++offset) {
+        forEachInCell(centreX - ring, centreY + offset, side, consider);
+        forEachInCell(centreX + ring, centreY + offset, side, consider);
+      }
+    }
+    if (out.size() == k &&
+        out.front().distance <= static_cast<float>(ring) * CELL_SIZE)
+      break;
+  }
+  sort_heap(out.begin(), out.end(), further);
+}
+
+optional<SpatialIndex::Hit> SpatialIndex::raycast(
+    float x, float y, float dirX, float dirY, float maxDistance, float radius,
+    optional<Side> side) const noexcept {
+  optional<Hit> best;
+  float radiusSquared = radius * radius;
+  auto consider = [&](uint32_t unit) {
+    // nearest intersection of the ray with the circle around the unit
+    float fx = xs[unit] - x;
+    float fy = ys[unit] - y;
+    float along = fx * dirX + fy * dirY;
+    float missSquared = fx * fx + fy * fy - along * along;
+    if (missSquared > radiusSquared) return;
+    float halfChord = sqrt(radiusSquared - missSquared);
+    if (along + halfChord < 0.0f) return;
+    float distance = max(along - halfChord, 0.0f);
+    if (distance > maxDistance) return;
+    if (!best.has_value() || distance < best->distance)
+      best = Hit{entities[unit], distance};
+  };
+
+  // step cell by cell along the ray, checking every cell a circle touching
+  // the ray in this cell could be centred in
+  int32_t reach = static_cast<int32_t>(ceil(radius / CELL_SIZE));
+  int32_t cellX = cellOf(x);
+  int32_t cellY = cellOf(y);
+  int32_t stepX = dirX < 0.0f ? -1 : 1;
+  int32_t stepY = dirY < 0.0f ? -1 : 1;
+  float inf = numeric_limits<float>::infinity();
+  float deltaX = dirX != 0.0f ? CELL_SIZE / abs(dirX) : inf;
+  float deltaY = dirY != 0.0f ? CELL_SIZE / abs(dirY) : inf;
+  float nextX =
+      dirX != 0.0f
+          ? ((static_cast<float>(cellX + (stepX > 0 ? 1 : 0)) * CELL_SIZE) -
+             x) / dirX
+          : inf;
+  float nextY =
+      dirY != 0.0f
+          ? ((static_cast<float>(cellY + (stepY > 0 ? 1 : 0)) * CELL_SIZE) -
+             y) / dirY
+          : inf;
+  while (true) {
+    for (int32_t offsetY = -reach; offsetY <= reach; ++offsetY)
+      for (int32_t offsetX = -reach; offsetX <= reach; ++offsetX)
+        forEachInCell(cellX + offsetX, cellY + offsetY, side, consider);
+
+    // every hit before the ray leaves this cell has now been seen
+    float exit = min(nextX, nextY);
+    if (best.has_value() && best->distance <= exit) break;
+    if (exit > maxDistance) break;
+    if (nextX < nextY) {
+      cellX += stepX;
+      nextX += deltaX;
+    } else {
+      cellY += stepY;
+      nextY += deltaY;
+    }
+    // past the occupied cells, heading away
+    if ((stepX > 0 ? cellX - reach > maxCellX : cellX + reach < minCellX) ||
+        (stepY > 0 ? cellY - reach > maxCellY : cellY + reach < minCellY))
+      break;
+  }
+  return best;
+}
+
+size_t SpatialIndex::size() const noexcept { return entities.size(); }
+
+int32_t SpatialIndex::cellOf(float coordinate) noexcept {
+  return static_cast<int32_t>(floor(coordinate / CELL_SIZE));
+}
+
+uint32_t SpatialIndex::bucketOf(int32_t cellX, int32_t cellY) const noexcept {
+  uint32_t hash = static_cast<uint32_t>(cellX) * 0x9E3779B1u ^
+                  static_cast<uint32_t>(cellY) * 0x85EBCA77u;
+  return (hash ^ (hash >> 15)) & bucketMask;
+}
+}  // namespace carrier_conquest::game
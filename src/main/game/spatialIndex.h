@@ -0,0 +1,122 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_GAME_SPATIALINDEX_H_
+#define CARRIERCONQUEST_GAME_SPATIALINDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "game/components.h"
+#include "game/entity.h"
+#include "game/world.h"
+
+namespace carrier_conquest::game {
+// broadphase for proximity and targeting queries
+// a uniform grid over the map, hashed into a table of buckets and rebuilt
+// from scratch each tick - a counting sort by bucket is cheaper than tracking
+// every move, and leaves each bucket's units contiguous in memory
+// once built it's read-only, so any number of threads may query it at once
+class SpatialIndex final {
+ public:
+  struct RangeQuery final {
+    float x;
+    float y;
+    float radius;
+    std::optional<Side> side;  // only units of this side, if given
+  };
+
+  struct Hit final {
+    Entity entity;
+    float distance;
+  };
+
+  SpatialIndex() noexcept;
+  SpatialIndex(SpatialIndex const &) noexcept = delete;
+  SpatialIndex(SpatialIndex &&) noexcept = default;
+
+  ~SpatialIndex() noexcept = default;
+
+  SpatialIndex &operator=(SpatialIndex const &) noexcept = delete;
+  SpatialIndex &operator=(SpatialIndex &&) noexcept = default;
+
+  // indexes every entity with a Position and an Allegiance
+  void rebuild(World const &world) noexcept;
+
+  // appends every unit within radius of (x, y) to out, in no particular order
+  void inRange(float x, float y, float radius, std::optional<Side> side,
+               std::vector<Entity> &out) const noexcept;
+  // answers queries[i] into results[i], spread over the job system
+  void inRange(std::span<RangeQuery const> queries,
+               std::span<std::vector<Entity>> results) const noexcept;
+  // replaces out with the (up to) k units nearest (x, y), nearest first
+  void nearest(float x, float y, size_t k, std::optional<Side> side,
+               std::vector<Hit> &out) const noexcept;
+  // the first unit within radius of the ray from (x, y) along the unit vector
+  // (dirX, dirY), no further than maxDistance away
+  std::optional<Hit> raycast(float x, float y, float dirX, float dirY,
+                             float maxDistance, float radius,
+                             std::optional<Side> side) const noexcept;
+
+  size_t size() const noexcept;
+
+  static constexpr float CELL_SIZE = 5'000.0f;  // metres
+
+ private:
+  // units, struct-of-arrays, sorted by bucket
+  std::vector<float> xs;
+  std::vector<float> ys;
+  std::vector<Entity> entities;
+  std::vector<Side> sides;
+  // bucket b holds units [bucketStarts[b], bucketStarts[b + 1])
+  std::vector<uint32_t> bucketStarts;
+  std::vector<uint32_t> unitBuckets;  // scratch for rebuild
+  uint32_t bucketMask;
+  // bounds of occupied cells
+  int32_t minCellX;
+  int32_t minCellY;
+  int32_t maxCellX;
+  int32_t maxCellY;
+
+  static int32_t cellOf(float coordinate) noexcept;
+  uint32_t bucketOf(int32_t cellX, int32_t cellY) const noexcept;
+
+  // calls f(unit) for each unit actually in the given cell - several cells
+  // may share a bucket, so the rest of the bucket is skipped
+  template <typename F>
+  void forEachInCell(int32_t cellX, int32_t cellY, std::optional<Side> side,
+                     F const &f) const noexcept {
+    if (cellX < minCellX || cellX > maxCellX || cellY < minCellY ||
+        cellY > maxCellY)
+      return;
+    uint32_t bucket = bucketOf(cellX, cellY);
+    for (uint32_t unit = bucketStarts[bucket]; unit < bucketStarts[bucket + 1];
+         ++unit) {
+      if (side.has_value() && sides[unit] != *side) continue;
+      if (cellOf(xs[unit]) != cellX || cellOf(ys[unit]) != cellY) continue;
+      f(unit);
+    }
+  }
+};
+}  // namespace carrier_conquest::game
+
+#endif  // CARRIERCONQUEST_GAME_SPATIALINDEX_H_
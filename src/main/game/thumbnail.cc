@@ -0,0 +1,138 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "game/thumbnail.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include "game/game.h"
+
+using namespace std;
+
+namespace carrier_conquest::game {
+namespace {
+// later entries are drawn over, and kept over, earlier ones
+enum Colour : uint8_t {
+  BACKGROUND,
+  STAR,
+  PLAYER,
+  ENEMY,
+  COLOUR_COUNT,
+};
+
+// RGB565
+constexpr array<uint16_t, COLOUR_COUNT> PALETTE = {
+    0x0863,  // near black
+    0x8410,  // grey
+    0x34bf,  // blue
+    0xf986,  // red
+};
+
+using Pixels = array<Colour, THUMBNAIL_SIZE * THUMBNAIL_SIZE>;
+
+void plot(Pixels &pixels, Position const &position, Colour colour) noexcept {
+  int column = static_cast<int>(position.x / GameState::MAP_SIZE *
+                                static_cast<float>(THUMBNAIL_SIZE));
+  int row = static_cast<int>(position.y / GameState::MAP_SIZE *
+                             static_cast<float>(THUMBNAIL_SIZE));
+  int size = static_cast<int>(THUMBNAIL_SIZE);
+  if (column < 0 || column >= size || row < 0 || row >= size) return;
+  // the map's top row is the image's last
+  Colour &pixel = pixels[static_cast<size_t>((size - 1 - row) * size + column)];
+  pixel = max(pixel, colour);
+}
+
+int distance(uint16_t a, uint16_t b) noexcept {
+  int red = (a >> 11) - (b >> 11);
+  int green = (a >> 5 & 0x3f) - (b >> 5 & 0x3f);
+  int blue = (a & 0x1f) - (b & 0x1f);
+  return red * red + green * green + blue * blue;
+}
+
+// there are few enough colours that a block's endpoints can be two of them -
+// the commonest, and whichever other is drawn on top - so those are exact
+void encodeBlock(Pixels const &pixels, size_t blockColumn, size_t blockRow,
+                 std::byte *out) noexcept {
+  array<Colour, 16> block;
+  array<unsigned, COLOUR_COUNT> counts = {};
+  for (size_t row = 0; row < 4; ++row) {
+    for (size_t column = 0; column < 4; ++column) {
+      Colour colour = pixels[(blockRow * 4 + row) * THUMBNAIL_SIZE +
+                             blockColumn * 4 + column];
+      block[row * 4 + column] = colour;
+      ++counts[colour];
+    }
+  }
+  Colour common = static_cast<Colour>(
+      max_element(counts.begin(), counts.end()) - counts.begin());
+  Colour top = common;
+  for (uint8_t colour = COLOUR_COUNT; colour-- > 0;) {
+    if (colour != common && counts[colour] != 0) {
+      top = static_cast<Colour>(colour);
+      break;
+    }
+  }
+
+  // four-colour mode needs the first endpoint to be the greater
+  uint16_t c0 = max(PALETTE[common], PALETTE[top]);
+  uint16_t c1 = min(PALETTE[common], PALETTE[top]);
+  uint32_t indices = 0;
+  if (c0 != c1) {
+    for (size_t idx = 0; idx < block.size(); ++idx) {
+      uint16_t colour = PALETTE[block[idx]];
+      if (distance(colour, c1) < distance(colour, c0))
+        indices |= uint32_t{1} << (2 * idx);
+    }
+  }
+
+  memcpy(out, &c0, sizeof(c0));
+  memcpy(out + 2, &c1, sizeof(c1));
+  memcpy(out + 4, &indices, sizeof(indices));
+}
+}  // namespace
+
+void drawThumbnail(World const &world,
+                   span<std::byte, THUMBNAIL_BYTES> out) noexcept {
+  Pixels pixels;
+  pixels.fill(BACKGROUND);
+
+  ComponentStore<StarSystem> const &systems = world.store<StarSystem>();
+  for (Entity system : systems.getEntities())
+    if (Position const *position = world.get<Position>(system))
+      plot(pixels, *position, STAR);
+
+  ComponentStore<Ship> const &ships = world.store<Ship>();
+  for (Entity ship : ships.getEntities()) {
+    Position const *position = world.get<Position>(ship);
+    Allegiance const *allegiance = world.get<Allegiance>(ship);
+    if (position == nullptr || allegiance == nullptr) continue;
+    plot(pixels, *position,
+         allegiance->side == Side::PLAYER ? PLAYER : ENEMY);
+  }
+
+  size_t blocks = THUMBNAIL_SIZE / 4;
+  for (size_t blockRow = 0; blockRow < blocks; ++blockRow)
+    for (size_t blockColumn = 0; blockColumn < blocks; ++blockColumn)
+      encodeBlock(pixels, blockColumn, blockRow,
+                  out.data() + (blockRow * blocks + blockColumn) * 8);
+}
+}  // namespace carrier_conquest::game
@@ -0,0 +1,36 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_GAME_THUMBNAIL_H_
+#define CARRIERCONQUEST_GAME_THUMBNAIL_H_
+
+#include <cstddef>
+#include <span>
+
+#include "game/saveFormat.h"
+#include "game/world.h"
+
+namespace carrier_conquest::game {
+// draws a map of the campaign - star systems and ships, by side - as
+// THUMBNAIL_SIZE square BC1 blocks, bottom row first
+void drawThumbnail(World const &world,
+                   std::span<std::byte, THUMBNAIL_BYTES> out) noexcept;
+}  // namespace carrier_conquest::game
+
+#endif  // CARRIERCONQUEST_GAME_THUMBNAIL_H_
@@ -0,0 +1,116 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_GAME_WORLD_H_
+#define CARRIERCONQUEST_GAME_WORLD_H_
+
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <utility>
+
+#include "game/componentStore.h"
+#include "game/components.h"
+#include "game/entity.h"
+
+namespace carrier_conquest::game {
+// every simulated object in a campaign, stored as components
+class World final {
+ public:
+  World() noexcept;
+  World(World const &) noexcept = delete;
+  World(World &&) noexcept = default;
+
+  ~World() noexcept = default;
+
+  World &operator=(World const &) noexcept = delete;
+  World &operator=(World &&) noexcept = default;
+
+  Entity create();
+  // removes the entity and all of its components
+  void destroy(Entity entity) noexcept;
+  bool alive(Entity entity) const noexcept;
+  uint32_t size() const noexcept;
+
+  // for saving and loading
+  EntityAllocator const &getAllocator() const noexcept;
+  EntityAllocator &getAllocator() noexcept;
+
+  template <typename T>
+  ComponentStore<T> &store() noexcept {
+    return std::get<ComponentStore<T>>(stores);
+  }
+  template <typename T>
+  ComponentStore<T> const &store() const noexcept {
+    return std::get<ComponentStore<T>>(stores);
+  }
+
+  template <typename T>
+  T &add(Entity entity, T component) {
+    assert(alive(entity) && "can't add components to a destroyed entity");
+    return store<T>().add(entity, std::move(component));
+  }
+  template <typename T>
+  void remove(Entity entity) noexcept {
+    store<T>().remove(entity);
+  }
+  template <typename T>
+  bool has(Entity entity) const noexcept {
+    return store<T>().has(entity);
+  }
+  template <typename T>
+  T *get(Entity entity) noexcept {
+    return store<T>().get(entity);
+  }
+  template <typename T>
+  T const *get(Entity entity) const noexcept {
+    return store<T>().get(entity);
+  }
+
+  // calls f(entity, first, rest...) for every entity with all the given
+  // components, walking the dense array of the first in order - put the
+  // rarest component first
+  template <typename First, typename... Rest, typename F>
+  void each(F &&f) {
+    ComponentStore<First> &first = store<First>();
+    std::span<Entity const> entities = first.getEntities();
+    std::span<First> components = first.getComponents();
+    for (size_t idx = 0; idx < components.size(); ++idx) {
+      Entity entity = entities[idx];
+      if ((has<Rest>(entity) && ...))
+        f(entity, components[idx], *get<Rest>(entity)...);
+    }
+  }
+
+ private:
+  EntityAllocator allocator;
+  std::tuple<ComponentStore<Position>, ComponentStore<PreviousPosition>,
+             ComponentStore<Velocity>,
+             ComponentStore<Allegiance>, ComponentStore<Hull>,
+             ComponentStore<Ship>, ComponentStore<Carrier>,
+             ComponentStore<Squadron>, ComponentStore<Projectile>,
+             ComponentStore<Fleet>, ComponentStore<Sector>,
+             ComponentStore<StarSystem>, ComponentStore<Spotted>,
+             ComponentStore<Selected>>
+      stores;
+};
+}  // namespace carrier_conquest::game
+
+#endif  // CARRIERCONQUEST_GAME_WORLD_H_
@@ -18,22 +18,28 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include <SDL2/SDL.h>
-#include <stb_image.h>
 
 #include <iostream>
 #include <sstream>
 
+#include "game/game.h"
 #include "options.h"
 #include "ui/components.h"
+#include "ui/renderState.h"
 #include "ui/resources.h"
 #include "ui/scene/mainMenu.h"
 #include "ui/scene/scene.h"
+#include "ui/shaderCache.h"
+#include "ui/spriteBatch.h"
 #include "ui/window.h"
+#include "util/assetPack.h"
 #include "util/exceptions/initException.h"
+#include "util/jobSystem.h"
 #include "version.h"
 
 using namespace std;
 using namespace carrier_conquest;
+using namespace carrier_conquest::util;
 using namespace carrier_conquest::util::exceptions;
 using namespace carrier_conquest::ui;
 using namespace carrier_conquest::ui::scene;
@@ -83,16 +89,18 @@ int main(int argc, char **) {
       throw InitException("Incompatible FreeType version", ss.str());
     }
 
-    // initialize stbi
-    stbi_set_flip_vertically_on_load(true);
-
     // set up static objects
+    jobs = make_unique<JobSystem>();
+    assets = make_unique<AssetPack>(ASSET_PACK);
     options = make_unique<Options>();
     window = make_unique<Window>();
+    renderState = make_unique<RenderState>();
+    shaderCache = make_unique<ShaderCache>();
     resources = make_unique<ResourceManager>();
 
     // load resources
     resources->loadSplash();
+    sprites = make_unique<SpriteBatch>();
     SDL_SetCursor(resources->busyCursor.get());
     Background2D splash(resources->splash);
     splash.draw();
@@ -104,6 +112,10 @@ int main(int argc, char **) {
     NextScene next = NextScene(mainMenu);
     while (next) next = next();
 
+    // the last save is written by the job system, so must finish before it
+    // shuts down
+    game::gameState = unique_ptr<game::GameState>();
+
     return EXIT_SUCCESS;
   } catch (InitException const &e) {
     if (SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, e.getTitle().c_str(),
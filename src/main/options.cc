@@ -22,7 +22,9 @@
 #include <filesystem>
 #include <fstream>
 #include <nlohmann/json.hpp>
+#include <span>
 
+#include "util/assetPack.h"
 #include "util/exceptions/initException.h"
 #include "util/paths.h"
 
@@ -46,27 +48,31 @@ void to_json(json &j, Options const &o) {
   j["msaa"] = o.msaa;
   j["vsync"] = o.vsync;
   j["playTutorial"] = o.playTutorial;
+  j["vramBudget"] = o.vramBudget;
 }
 void from_json(json const &j, Options &o) {
   j.at("msaa").get_to(o.msaa);
   j.at("vsync").get_to(o.vsync);
   j.at("playTutorial").get_to(o.playTutorial);
+  // added after release - older options files won't have it
+  o.vramBudget = j.value("vramBudget", Options::DEFAULT_VRAM_BUDGET);
 }
 
 Options::Options() {
   path optionsPath = getSavePath() / "options.json";
-  if (!exists(optionsPath)) {
-    optionsPath = ASSET_PREFIX;
-    optionsPath /= "defaultOptions.json";
-  }
 
   try {
-    ifstream fin;
-    fin.exceptions(ifstream::failbit | ifstream::badbit);
-    fin.open(optionsPath, ios_base::in | ios_base::binary);
-
     json j;
-    fin >> j;
+    if (exists(optionsPath)) {
+      ifstream fin;
+      fin.exceptions(ifstream::failbit | ifstream::badbit);
+      fin.open(optionsPath, ios_base::in | ios_base::binary);
+      fin >> j;
+    } else {
+      span<std::byte const> defaults = assets->get("defaultOptions.json");
+      char const *begin = reinterpret_cast<char const *>(defaults.data());
+      j = json::parse(begin, begin + defaults.size());
+    }
     j.get_to(*this);
   } catch (ios_base::failure const &e) {
     throw InitException("Could not read options file", e.what());
@@ -28,6 +28,9 @@ class Options final {
   enum class MSAALevel { ZERO = 0, TWO = 2, FOUR = 4, EIGHT = 8 } msaa;
   bool vsync;
   bool playTutorial;
+  unsigned vramBudget;  // MiB, for scene resources
+
+  static constexpr unsigned DEFAULT_VRAM_BUDGET = 256;
 
   Options();
   Options(Options const &) noexcept = delete;
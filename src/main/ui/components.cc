@@ -19,20 +19,15 @@
 
 #include "ui/components.h"
 
-#include <vector>
+#include <string>
 
 #include "window.h"
 
-using namespace carrier_conquest::util;
 using namespace std;
 using namespace glm;
 
 namespace carrier_conquest::ui {
 namespace {
-float clipX(float x) { return x * 2.0f - 1.0f; }
-
-float clipY(float y) { return (1.0f - y) * 2.0f - 1.0f; }
-
 float scaleX(Texture2D const &tex) {
   return tex.getWidth() / Texture2D::SCREEN_WIDTH;
 }
@@ -49,33 +44,35 @@ float distance(float x1, float y1, float x2, float y2) {
   return sqrt(pow(x1 - x2, 2) + pow(y1 - y2, 2));
 }
 
-void drawChar(Font &font, VBO &glyphVBO, float &x, float y,
-              char32_t c) noexcept {
-  Glyph &glyph = font.glyph(c);
-  glyphVBO.update({clipX(x + glyph.xMin / window->getWidth()),
-                   clipY(y - glyph.yMin / window->getHeight()), 0.0f, 1.0f,
-                   clipX(x + glyph.xMax / window->getWidth()),
-                   clipY(y - glyph.yMin / window->getHeight()), 1.0f, 1.0f,
-                   clipX(x + glyph.xMax / window->getWidth()),
-                   clipY(y - glyph.yMax / window->getHeight()), 1.0f, 0.0f,
-                   clipX(x + glyph.xMin / window->getWidth()),
-                   clipY(y - glyph.yMax / window->getHeight()), 0.0f, 0.0f},
-                  0);
-  glyph.texture.use(GL_TEXTURE0);
-  resources->text2D.setUniform("tex", 0);
-  glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
-  x += glyph.advance / window->getWidth();
+SpriteBatch::Rect screenRect(Texture2D const &tex, float x, float y) {
+  return SpriteBatch::Rect{x, y + scaleY(tex), x + scaleX(tex), y};
+}
+
+float drawText(Font &font, u32string const &text, float x, float y,
+               vec4 const &colour) noexcept {
+  for (char32_t c : text) {
+    Glyph glyph = font.glyph(c);
+    if (glyph.region.page != nullptr)
+      sprites->draw(SpriteBatch::Layer::TEXT, resources->text2D,
+                    glyph.region.page,
+                    {x + glyph.xMin / window->getWidth(),
+                     y - glyph.yMin / window->getHeight(),
+                     x + glyph.xMax / window->getWidth(),
+                     y - glyph.yMax / window->getHeight()},
+                    {glyph.region.sMin, glyph.region.tMax, glyph.region.sMax,
+                     glyph.region.tMin},
+                    colour);
+    x += glyph.advance / window->getWidth();
+  }
+  return x;
 }
 }  // namespace
 
 Background2D::Background2D(Texture2D &texture) noexcept : texture(texture) {}
 
 void Background2D::draw() noexcept {
-  texture.use(GL_TEXTURE0);
-  ScopeGuard guard = resources->backgroundVAO.use();
-  resources->image2D.use();
-  resources->image2D.setUniform("tex", 0);
-  glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+  sprites->draw(SpriteBatch::Layer::BACKGROUND, texture,
+                {0.0f, 1.0f, 1.0f, 0.0f});
 }
 
 Image2D Image2D::centered(Texture2D &texture, float x, float y) noexcept {
@@ -87,30 +84,10 @@ Image2D Image2D::alignBottom(Texture2D &texture, float x, float y) noexcept {
 }
 Image2D::Image2D(Texture2D &texture, float x, float y) noexcept
     : texture(texture),
-      vbo(
-          {
-              clipX(x), clipY(y + scaleY(texture)),  // bottom left pos
-              0.0f, 0.0f,                            // bottom left tex
-
-              clipX(x + scaleX(texture)),
-              clipY(y + scaleY(texture)),  // bottom right pos
-              1.0f, 0.0f,                  // bottom right tex
-
-              clipX(x + scaleX(texture)), clipY(y),  // top right pos
-              1.0f, 1.0f,                            // top right tex
-
-              clipX(x), clipY(y),  // top left pos
-              0.0f, 1.0f,          // top left tex
-          },
-          GL_STATIC_DRAW),
-      vao(vbo, resources->quadEBO, resources->quadAttributes) {}
+      bounds(screenRect(texture, x, y)) {}
 
 void Image2D::draw() noexcept {
-  texture.use(GL_TEXTURE0);
-  ScopeGuard guard = vao.use();
-  resources->image2D.use();
-  resources->image2D.setUniform("tex", 0);
-  glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+  sprites->draw(SpriteBatch::Layer::WIDGET, texture, bounds);
 }
 
 Clickable::Clickable() noexcept : active(false) {}
@@ -139,23 +116,7 @@ Button2D::Button2D(Texture2D &onTexture, Texture2D &offTexture, float x,
                    float y) noexcept
     : onTexture(onTexture),
       offTexture(offTexture),
-      vbo(
-          {
-              clipX(x), clipY(y + scaleY(onTexture)),  // bottom left pos
-              0.0f, 0.0f,                              // bottom left tex
-
-              clipX(x + scaleX(onTexture)),
-              clipY(y + scaleY(onTexture)),  // bottom right pos
-              1.0f, 0.0f,                    // bottom right tex
-
-              clipX(x + scaleX(onTexture)), clipY(y),  // top right pos
-              1.0f, 1.0f,                              // top right tex
-
-              clipX(x), clipY(y),  // top left pos
-              0.0f, 1.0f,          // top left tex
-          },
-          GL_STATIC_DRAW),
-      vao(vbo, resources->quadEBO, resources->quadAttributes),
+      bounds(screenRect(onTexture, x, y)),
       left(x * window->getWidth()),
       right((x + scaleX(onTexture)) * window->getWidth()),
       top(y * window->getHeight()),
@@ -167,11 +128,8 @@ Button2D::Button2D(Texture2D &onTexture, Texture2D &offTexture, float x,
 }
 
 void Button2D::draw() noexcept {
-  (active ? onTexture : offTexture).use(GL_TEXTURE0);
-  ScopeGuard guard = vao.use();
-  resources->image2D.use();
-  resources->image2D.setUniform("tex", 0);
-  glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+  sprites->draw(SpriteBatch::Layer::WIDGET, active ? onTexture : offTexture,
+                bounds);
 }
 
 bool Button2D::clicked(int32_t x, int32_t y) const noexcept {
@@ -203,74 +161,40 @@ Textbox2D::Textbox2D(Font &font, Texture2D &texture, vec4 const &colour,
     : font(font),
       texture(texture),
       colour(colour),
-      vbo(
-          {
-              clipX(x), clipY(y + scaleY(texture)),  // bottom left pos
-              0.0f, 0.0f,                            // bottom left tex
-
-              clipX(x + scaleX(texture)),
-              clipY(y + scaleY(texture)),  // bottom right pos
-              1.0f, 0.0f,                  // bottom right tex
-
-              clipX(x + scaleX(texture)), clipY(y),  // top right pos
-              1.0f, 1.0f,                            // top right tex
-
-              clipX(x), clipY(y),  // top left pos
-              0.0f, 1.0f,          // top left tex
-          },
-          GL_STATIC_DRAW),
-      vao(vbo, resources->quadEBO, resources->quadAttributes),
+      bounds(screenRect(texture, x, y)),
       left(x * window->getWidth()),
       right((x + scaleX(texture)) * window->getWidth()),
       top(y * window->getHeight()),
       bottom((y + scaleY(texture)) * window->getHeight()),
       preCursor(),
       composition(),
-      postCursor(),
-      glyphVBO(vector<float>(16), GL_DYNAMIC_DRAW),
-      glyphVAO(glyphVBO, resources->quadEBO, resources->quadAttributes),
-      cursorVBO(vector<float>(4), GL_DYNAMIC_DRAW),
-      cursorVAO(cursorVBO, resources->cursorEBO, resources->cursorAttributes) {}
+      postCursor() {}
 
 Textbox2D::operator std::u32string() const noexcept {
   return preCursor + composition + postCursor;
 }
 
 void Textbox2D::draw() noexcept {
-  texture.use(GL_TEXTURE0);
-  ScopeGuard guard = vao.use();
-  resources->image2D.use();
-  resources->image2D.setUniform("tex", 0);
-  glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+  sprites->draw(SpriteBatch::Layer::WIDGET, texture, bounds);
 
   font.setSize(bottom - top - 2.0f * tex2Window(RADIUS));
 
-  Glyph const &bar = font.glyph(U'|');
+  Glyph bar = font.glyph(U'|');
   float baseline =
       (bottom - tex2Window(RADIUS) + bar.yMin) / window->getHeight();
-  float left = (left + tex2Window(RADIUS)) / window->getWidth();
-
-  glyphVAO.use(guard);
-  resources->text2D.use();
-  resources->text2D.setUniform("colour", colour);
-  for (char32_t const &c : preCursor)
-    drawChar(font, glyphVBO, left, baseline, c);
-  for (char32_t const &c : composition)
-    drawChar(font, glyphVBO, left, baseline, c);
-  float cursorPos = left;
-  for (char32_t const &c : postCursor)
-    drawChar(font, glyphVBO, left, baseline, c);
+  float x = (left + tex2Window(RADIUS)) / window->getWidth();
+
+  x = drawText(font, preCursor, x, baseline, colour);
+  x = drawText(font, composition, x, baseline, colour);
+  float cursorPos = x;
+  drawText(font, postCursor, x, baseline, colour);
   if (active) {
-    cursorVAO.use(guard);
-    cursorVBO.update(
-        {clipX(cursorPos),
-         clipY((bottom - tex2Window(RADIUS)) / window->getHeight()),
-         clipX(cursorPos),
-         clipY((top + tex2Window(RADIUS)) / window->getHeight())},
-        0);
-    resources->solid2D.use();
-    resources->solid2D.setUniform("colour", {0.0f, 0.0f, 0.0f, 1.0f});
-    glDrawElements(GL_LINES, 2, GL_UNSIGNED_INT, nullptr);
+    sprites->draw(
+        SpriteBatch::Layer::OVERLAY, resources->solid2D, nullptr,
+        {cursorPos, (bottom - tex2Window(RADIUS)) / window->getHeight(),
+         cursorPos + 1.0f / window->getWidth(),
+         (top + tex2Window(RADIUS)) / window->getHeight()},
+        {0.0f, 0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f, 1.0f});
   }
 
   // TODO: cursor blink
@@ -353,51 +277,81 @@ TextField2D TextField2D::centered(Font &font, Texture2D &texture,
 TextField2D::TextField2D(Font &font_, Texture2D &texture_, vec4 const &colour_,
                          float x, float y) noexcept
     : text(),
-      font(font),
-      texture(texture),
-      colour(colour),
-      vbo(
-          {
-              clipX(x), clipY(y + scaleY(texture)),  // bottom left pos
-              0.0f, 0.0f,                            // bottom left tex
-
-              clipX(x + scaleX(texture)),
-              clipY(y + scaleY(texture)),  // bottom right pos
-              1.0f, 0.0f,                  // bottom right tex
-
-              clipX(x + scaleX(texture)), clipY(y),  // top right pos
-              1.0f, 1.0f,                            // top right tex
-
-              clipX(x), clipY(y),  // top left pos
-              0.0f, 1.0f,          // top left tex
-          },
-          GL_STATIC_DRAW),
-      vao(vbo, resources->quadEBO, resources->quadAttributes),
+      font(font_),
+      texture(texture_),
+      colour(colour_),
+      bounds(screenRect(texture, x, y)),
       left(x * window->getWidth()),
       right((x + scaleX(texture)) * window->getWidth()),
       top(y * window->getHeight()),
-      bottom((y + scaleY(texture)) * window->getHeight()),
-      glyphVBO(vector<float>(16), GL_DYNAMIC_DRAW),
-      glyphVAO(glyphVBO, resources->quadEBO, resources->quadAttributes) {}
+      bottom((y + scaleY(texture)) * window->getHeight()) {}
 
 void TextField2D::draw() noexcept {
-  texture.use(GL_TEXTURE0);
-  ScopeGuard guard = vao.use();
-  resources->image2D.use();
-  resources->image2D.setUniform("tex", 0);
-  glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+  sprites->draw(SpriteBatch::Layer::WIDGET, texture, bounds);
 
   font.setSize(bottom - top - 2.0f * tex2Window(RADIUS));
 
-  Glyph const &bar = font.glyph(U'|');
+  Glyph bar = font.glyph(U'|');
   float baseline =
       (bottom - tex2Window(RADIUS) + bar.yMin) / window->getHeight();
-  float left = (left + tex2Window(RADIUS)) / window->getWidth();
+  float x = (left + tex2Window(RADIUS)) / window->getWidth();
+
+  drawText(font, text, x, baseline, colour);
+}
+
+ListItem2D ListItem2D::centered(Font &font, Texture2D *thumbnail,
+                                u32string title, u32string detail, float x,
+                                float y) noexcept {
+  return ListItem2D(font, thumbnail, move(title), move(detail),
+                    x - WIDTH / Texture2D::SCREEN_WIDTH / 2.0f,
+                    y - HEIGHT / Texture2D::SCREEN_HEIGHT / 2.0f);
+}
+
+ListItem2D::ListItem2D(Font &font_, Texture2D *thumbnail_, u32string title_,
+                       u32string detail_, float x, float y) noexcept
+    : font(font_),
+      thumbnail(thumbnail_),
+      title(move(title_)),
+      detail(move(detail_)),
+      bounds{x, y + HEIGHT / Texture2D::SCREEN_HEIGHT,
+             x + WIDTH / Texture2D::SCREEN_WIDTH, y},
+      left(x * window->getWidth()),
+      right((x + WIDTH / Texture2D::SCREEN_WIDTH) * window->getWidth()),
+      top(y * window->getHeight()),
+      bottom((y + HEIGHT / Texture2D::SCREEN_HEIGHT) * window->getHeight()) {}
+
+void ListItem2D::draw() noexcept {
+  sprites->draw(SpriteBatch::Layer::WIDGET, resources->solid2D, nullptr,
+                bounds, {0.0f, 0.0f, 0.0f, 0.0f},
+                active ? vec4(1.0f, 1.0f, 1.0f, 0.25f)
+                       : vec4(0.0f, 0.0f, 0.0f, 0.5f));
+
+  float padding = tex2Window(PADDING);
+  float x = left + padding;
+  if (thumbnail != nullptr) {
+    // square, as tall as the row allows
+    float size = bottom - top - 2.0f * padding;
+    sprites->draw(SpriteBatch::Layer::TEXT, *thumbnail,
+                  {x / window->getWidth(),
+                   (bottom - padding) / window->getHeight(),
+                   (x + size) / window->getWidth(),
+                   (top + padding) / window->getHeight()});
+    x += size + padding;
+  }
+
+  float height = bottom - top;
+  font.setSize(height * 0.4f);
+  drawText(font, title, x / window->getWidth(),
+           (top + height * 0.5f) / window->getHeight(),
+           vec4(1.0f, 1.0f, 1.0f, 1.0f));
+  font.setSize(height * 0.25f);
+  drawText(font, detail, x / window->getWidth(),
+           (top + height * 0.85f) / window->getHeight(),
+           vec4(0.8f, 0.8f, 0.8f, 1.0f));
+}
 
-  glyphVAO.use(guard);
-  resources->text2D.use();
-  resources->text2D.setUniform("colour", colour);
-  for (char32_t const &c : text) drawChar(font, glyphVBO, left, baseline, c);
+bool ListItem2D::clicked(int32_t x, int32_t y) const noexcept {
+  return left <= x && x <= right && top <= y && y <= bottom;
 }
 
 float layout(size_t index, size_t count) noexcept {
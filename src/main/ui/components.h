@@ -20,9 +20,12 @@
 #ifndef CARRIERCONQUEST_UI_COMPONENTS_H_
 #define CARRIERCONQUEST_UI_COMPONENTS_H_
 
+#include <functional>
+#include <string>
 #include <vector>
 
 #include "ui/resources.h"
+#include "ui/spriteBatch.h"
 
 namespace carrier_conquest::ui {
 class Background2D final {
@@ -58,8 +61,7 @@ class Image2D final {
 
  private:
   Texture2D &texture;
-  VBO vbo;
-  VAO vao;
+  SpriteBatch::Rect bounds;
 
   Image2D(Texture2D &, float x, float y) noexcept;
 };
@@ -186,8 +188,7 @@ class Button2D final : public Clickable {
  private:
   Texture2D &onTexture;
   Texture2D &offTexture;
-  VBO vbo;
-  VAO vao;
+  SpriteBatch::Rect bounds;
   float left;
   float right;
   float top;
@@ -229,8 +230,7 @@ class Textbox2D final : public Clickable {
   Font &font;
   Texture2D &texture;
   glm::vec4 colour;
-  VBO vbo;
-  VAO vao;
+  SpriteBatch::Rect bounds;
   float left;
   float right;
   float top;
@@ -239,17 +239,10 @@ class Textbox2D final : public Clickable {
   std::u32string composition;
   std::u32string postCursor;
 
-  VBO glyphVBO;
-  VAO glyphVAO;
-  VBO cursorVBO;
-  VAO cursorVAO;
-
   static constexpr float RADIUS = 25.0f;
 
   Textbox2D(Font &font, Texture2D &texture, glm::vec4 const &colour, float x,
             float y) noexcept;
-
-  void drawCursor(float x) noexcept;
 };
 
 class TextField2D final {
@@ -273,22 +266,58 @@ class TextField2D final {
   Font &font;
   Texture2D &texture;
   glm::vec4 colour;
-  VBO vbo;
-  VAO vao;
+  SpriteBatch::Rect bounds;
   float left;
   float right;
   float top;
   float bottom;
 
-  VBO glyphVBO;
-  VAO glyphVAO;
-
   static constexpr float RADIUS = 0.0f;
 
   TextField2D(Font &font, Texture2D &texture, glm::vec4 const &colour, float x,
               float y) noexcept;
 };
 
+// a row of a list - a thumbnail, if there is one, then a title over a line
+// of detail
+class ListItem2D final : public Clickable {
+ public:
+  static ListItem2D centered(Font &font, Texture2D *thumbnail,
+                             std::u32string title, std::u32string detail,
+                             float x, float y) noexcept;
+  ListItem2D(ListItem2D const &) noexcept = delete;
+  ListItem2D(ListItem2D &&) noexcept = default;
+
+  ~ListItem2D() noexcept override = default;
+
+  ListItem2D &operator=(ListItem2D const &) noexcept = delete;
+  ListItem2D &operator=(ListItem2D &&) noexcept = default;
+
+  void draw() noexcept;
+
+  bool clicked(int32_t x, int32_t y) const noexcept override;
+
+  // in screen texture pixels
+  static constexpr float WIDTH = 1200.0f;
+  static constexpr float HEIGHT = 120.0f;
+
+ private:
+  Font &font;
+  Texture2D *thumbnail;
+  std::u32string title;
+  std::u32string detail;
+  SpriteBatch::Rect bounds;
+  float left;
+  float right;
+  float top;
+  float bottom;
+
+  static constexpr float PADDING = 10.0f;
+
+  ListItem2D(Font &font, Texture2D *thumbnail, std::u32string title,
+             std::u32string detail, float x, float y) noexcept;
+};
+
 float layout(size_t index, size_t count) noexcept;
 }  // namespace carrier_conquest::ui
 
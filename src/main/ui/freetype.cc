@@ -19,6 +19,8 @@
 
 #include "ui/freetype.h"
 
+#include FT_MODULE_H
+
 #include "util/exceptions/initException.h"
 
 using namespace carrier_conquest::util::exceptions;
@@ -32,7 +34,10 @@ FreeType::FreeType()
               throw InitException("Could not initialize FreeType");
             return library;
           }(),
-          FT_Done_FreeType) {}
+          FT_Done_FreeType) {
+  FT_Int spread = SDF_SPREAD;
+  FT_Property_Set(library.get(), "sdf", "spread", &spread);
+}
 
 FT_Library FreeType::get() noexcept { return library.get(); }
 
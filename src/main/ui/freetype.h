@@ -25,6 +25,10 @@
 #include "ft2build.h"
 #include FT_FREETYPE_H
 
+// signed distance field rendering (FT_RENDER_MODE_SDF)
+static_assert(FREETYPE_MAJOR > 2 || FREETYPE_MINOR >= 11,
+              "FreeType 2.11 or later is required");
+
 namespace carrier_conquest::ui {
 class FreeType final {
  public:
@@ -40,6 +44,9 @@ class FreeType final {
   FT_Library get() noexcept;
   FT_Library const get() const noexcept;
 
+  // distance, in pixels, that glyph distance fields extend past the outline
+  static constexpr FT_Int SDF_SPREAD = 8;
+
  private:
   std::unique_ptr<std::remove_pointer<FT_Library>::type,
                   decltype(&FT_Done_FreeType)>
@@ -0,0 +1,136 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ui/renderState.h"
+
+#include <cassert>
+
+using namespace std;
+
+namespace carrier_conquest::ui {
+RenderState::RenderState() noexcept
+    : program(UNKNOWN),
+      activeUnit(UNKNOWN),
+      textures(),
+      vertexArray(UNKNOWN),
+      arrayBuffer(UNKNOWN),
+      elementArrayBuffer(UNKNOWN),
+      pixelUnpackBuffer(UNKNOWN),
+      current{0, 0},
+      lastFrame{0, 0} {
+  textures.fill(UNKNOWN);
+}
+
+void RenderState::useProgram(unsigned id) noexcept {
+  if (changed(program, id)) glUseProgram(id);
+}
+
+void RenderState::bindTexture(unsigned id) noexcept {
+  if (activeUnit == UNKNOWN) {
+    activeUnit = 0;
+    glActiveTexture(GL_TEXTURE0);
+  }
+  bindTexture(activeUnit, id);
+}
+
+void RenderState::bindTexture(unsigned unit, unsigned id) noexcept {
+  assert((unit < TEXTURE_UNITS) && "texture unit out of range");
+  if (changed(textures[unit], id)) {
+    if (activeUnit != unit) {
+      activeUnit = unit;
+      glActiveTexture(GL_TEXTURE0 + unit);
+    }
+    glBindTexture(GL_TEXTURE_2D, id);
+  }
+}
+
+void RenderState::bindVertexArray(unsigned id) noexcept {
+  if (changed(vertexArray, id)) {
+    // the element array binding is part of the vertex array's state
+    elementArrayBuffer = UNKNOWN;
+    glBindVertexArray(id);
+  }
+}
+
+void RenderState::bindBuffer(GLenum target, unsigned id) noexcept {
+  switch (target) {
+    case GL_ARRAY_BUFFER: {
+      if (changed(arrayBuffer, id)) glBindBuffer(target, id);
+      break;
+    }
+    case GL_ELEMENT_ARRAY_BUFFER: {
+      if (changed(elementArrayBuffer, id)) glBindBuffer(target, id);
+      break;
+    }
+    case GL_PIXEL_UNPACK_BUFFER: {
+      if (changed(pixelUnpackBuffer, id)) glBindBuffer(target, id);
+      break;
+    }
+    default: {
+      ++current.issued;
+      glBindBuffer(target, id);
+      break;
+    }
+  }
+}
+
+void RenderState::forgetProgram(unsigned id) noexcept {
+  if (program == id) program = UNKNOWN;
+}
+
+void RenderState::forgetTexture(unsigned id) noexcept {
+  for (unsigned &texture : textures)
+    if (texture == id) texture = UNKNOWN;
+}
+
+void RenderState::forgetVertexArray(unsigned id) noexcept {
+  if (vertexArray == id) {
+    vertexArray = UNKNOWN;
+    elementArrayBuffer = UNKNOWN;
+  }
+}
+
+void RenderState::forgetBuffer(unsigned id) noexcept {
+  if (arrayBuffer == id) arrayBuffer = UNKNOWN;
+  if (elementArrayBuffer == id) elementArrayBuffer = UNKNOWN;
+  if (pixelUnpackBuffer == id) pixelUnpackBuffer = UNKNOWN;
+}
+
+void RenderState::endFrame() noexcept {
+  lastFrame = current;
+  current = Counters{0, 0};
+}
+
+RenderState::Counters const &RenderState::getFrameCounters() const noexcept {
+  return lastFrame;
+}
+
+bool RenderState::changed(unsigned &bound, unsigned id) noexcept {
+  if (bound == id) {
+    ++current.skipped;
+    return false;
+  } else {
+    ++current.issued;
+    bound = id;
+    return true;
+  }
+}
+
+unique_ptr<RenderState> renderState;
+}  // namespace carrier_conquest::ui
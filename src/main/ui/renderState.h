@@ -0,0 +1,82 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_UI_RENDERSTATE_H_
+#define CARRIERCONQUEST_UI_RENDERSTATE_H_
+
+#include <GL/glew.h>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+
+namespace carrier_conquest::ui {
+class RenderState final {
+ public:
+  struct Counters final {
+    size_t issued;
+    size_t skipped;
+  };
+
+  RenderState() noexcept;
+  RenderState(RenderState const &) noexcept = delete;
+  RenderState(RenderState &&) noexcept = delete;
+
+  ~RenderState() noexcept = default;
+
+  RenderState &operator=(RenderState const &) noexcept = delete;
+  RenderState &operator=(RenderState &&) noexcept = delete;
+
+  void useProgram(unsigned id) noexcept;
+  void bindTexture(unsigned id) noexcept;
+  void bindTexture(unsigned unit, unsigned id) noexcept;
+  void bindVertexArray(unsigned id) noexcept;
+  void bindBuffer(GLenum target, unsigned id) noexcept;
+
+  void forgetProgram(unsigned id) noexcept;
+  void forgetTexture(unsigned id) noexcept;
+  void forgetVertexArray(unsigned id) noexcept;
+  void forgetBuffer(unsigned id) noexcept;
+
+  void endFrame() noexcept;
+  Counters const &getFrameCounters() const noexcept;
+
+  static constexpr size_t TEXTURE_UNITS = 16;
+
+ private:
+  unsigned program;
+  unsigned activeUnit;
+  std::array<unsigned, TEXTURE_UNITS> textures;
+  unsigned vertexArray;
+  unsigned arrayBuffer;
+  unsigned elementArrayBuffer;
+  unsigned pixelUnpackBuffer;
+  Counters current;
+  Counters lastFrame;
+
+  // never a valid object name - forces the next bind through
+  static constexpr unsigned UNKNOWN = ~0u;
+
+  bool changed(unsigned &bound, unsigned id) noexcept;
+};
+
+extern std::unique_ptr<RenderState> renderState;
+}  // namespace carrier_conquest::ui
+
+#endif  // CARRIERCONQUEST_UI_RENDERSTATE_H_
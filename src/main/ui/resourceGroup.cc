@@ -0,0 +1,111 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ui/resourceGroup.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "ui/resources.h"
+#include "ui/textureLoader.h"
+#include "util/assetPack.h"
+#include "util/cookedTexture.h"
+#include "util/exceptions/initException.h"
+
+using namespace std;
+using namespace std::filesystem;
+using namespace carrier_conquest::util::exceptions;
+using namespace carrier_conquest::util;
+
+namespace carrier_conquest::ui {
+ResourceGroup::Pin::Pin() noexcept : group(nullptr) {}
+
+ResourceGroup::Pin::Pin(ResourceGroup &group) noexcept : group(&group) {
+  ++group.pins;
+}
+
+ResourceGroup::Pin::Pin(Pin &&other) noexcept : group(other.group) {
+  other.group = nullptr;
+}
+
+ResourceGroup::Pin::~Pin() noexcept {
+  if (group != nullptr) --group->pins;
+}
+
+ResourceGroup::Pin &ResourceGroup::Pin::operator=(Pin &&other) noexcept {
+  swap(group, other.group);
+  return *this;
+}
+
+ResourceGroup::ResourceGroup() noexcept
+    : entries(), loaded(0), pins(0), lastUsed(0) {}
+
+ResourceGroup::ResourceGroup(
+    initializer_list<pair<Texture2D *, path>> textures)
+    : ResourceGroup() {
+  for (auto const &[texture, filename] : textures) {
+    span<std::byte const> file = assets->get(path("textures") / filename);
+    if (!validCookedTexture(file))
+      throw InitException("Failed to load texture " + filename.string(),
+                          "Could not read file " + filename.string());
+    entries.push_back(Entry{texture, filename, file});
+  }
+}
+
+bool ResourceGroup::isLoaded() const noexcept {
+  return loaded == entries.size();
+}
+
+bool ResourceGroup::isPinned() const noexcept { return pins != 0; }
+
+// level data is uploaded as-is, so file sizes are a close upper bound on
+// what the textures cost in video memory - unless S3TC has to be decoded
+size_t ResourceGroup::getResidentSize() const noexcept {
+  size_t size = 0;
+  for (size_t idx = 0; idx < loaded; ++idx) size += entries[idx].file.size();
+  return size;
+}
+
+size_t ResourceGroup::getPendingSize() const noexcept {
+  size_t size = 0;
+  for (size_t idx = loaded; idx < entries.size(); ++idx)
+    size += entries[idx].file.size();
+  return size;
+}
+
+void ResourceGroup::readAhead() const noexcept {
+  for (size_t idx = loaded; idx < entries.size(); ++idx)
+    assets->prefetch(entries[idx].file);
+}
+
+void ResourceGroup::load(TextureLoader &loader, size_t count) noexcept {
+  size_t end = min(loaded + count, entries.size());
+  for (size_t idx = loaded; idx < end; ++idx)
+    loader.add(*entries[idx].texture, entries[idx].filename);
+  loader.start();
+  loader.finish();
+  loaded = end;
+}
+
+void ResourceGroup::evict() noexcept {
+  assert(!isPinned() && "can't evict a group that's in use");
+  for (size_t idx = 0; idx < loaded; ++idx) *entries[idx].texture = Texture2D();
+  loaded = 0;
+}
+}  // namespace carrier_conquest::ui
@@ -0,0 +1,98 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_UI_RESOURCEGROUP_H_
+#define CARRIERCONQUEST_UI_RESOURCEGROUP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <initializer_list>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace carrier_conquest::ui {
+class Texture2D;
+class TextureLoader;
+class ResourceManager;
+
+// the textures one scene needs - loaded when the scene pins the group, and
+// free to be evicted once nothing has it pinned
+class ResourceGroup final {
+  friend class ResourceManager;
+
+ public:
+  class Pin final {
+   public:
+    Pin() noexcept;
+    explicit Pin(ResourceGroup &group) noexcept;
+    Pin(Pin const &) noexcept = delete;
+    Pin(Pin &&) noexcept;
+
+    ~Pin() noexcept;
+
+    Pin &operator=(Pin const &) noexcept = delete;
+    Pin &operator=(Pin &&) noexcept;
+
+   private:
+    ResourceGroup *group;
+  };
+
+  ResourceGroup() noexcept;
+  // throws InitException if a texture is unreadable, or in a format the
+  // driver can't sample - so it's caught before the group is ever loaded
+  ResourceGroup(std::initializer_list<
+                std::pair<Texture2D *, std::filesystem::path>> textures);
+  ResourceGroup(ResourceGroup const &) noexcept = delete;
+  ResourceGroup(ResourceGroup &&) noexcept = default;
+
+  ~ResourceGroup() noexcept = default;
+
+  ResourceGroup &operator=(ResourceGroup const &) noexcept = delete;
+  ResourceGroup &operator=(ResourceGroup &&) noexcept = default;
+
+  bool isLoaded() const noexcept;
+  bool isPinned() const noexcept;
+
+  // bytes of texture data currently resident
+  size_t getResidentSize() const noexcept;
+  // bytes still to load before the group is resident
+  size_t getPendingSize() const noexcept;
+
+ private:
+  struct Entry final {
+    Texture2D *texture;
+    std::filesystem::path filename;
+    std::span<std::byte const> file;
+  };
+
+  std::vector<Entry> entries;
+  size_t loaded;  // entries before this index are resident
+  unsigned pins;
+  uint64_t lastUsed;
+
+  void readAhead() const noexcept;
+  // every entry was checked on construction, so loading can't fail
+  void load(TextureLoader &loader, size_t count) noexcept;
+  void evict() noexcept;
+};
+}  // namespace carrier_conquest::ui
+
+#endif  // CARRIERCONQUEST_UI_RESOURCEGROUP_H_
@@ -19,15 +19,23 @@
 
 #include "ui/resources.h"
 
-#include <stb_image.h>
-
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
+#include <span>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "glm/gtc/matrix_transform.hpp"
 #include "glm/gtc/type_ptr.hpp"
+#include "options.h"
+#include "ui/renderState.h"
+#include "ui/shaderCache.h"
+#include "ui/textureLoader.h"
+#include "util/assetPack.h"
+#include "util/cookedTexture.h"
 #include "util/exceptions/initException.h"
 
 using namespace std;
@@ -53,27 +61,23 @@ GLResource &GLResource::operator=(GLResource &&other) noexcept {
 unsigned GLResource::get() noexcept { return id; }
 
 Shader::Shader(GLenum type, path const &filename)
-    : GLResource(glCreateShader(type)) {
+    : type(type),
+      filename(filename),
+      source(assets->get(path("shaders") / filename)) {
   assert((type == GL_VERTEX_SHADER || type == GL_FRAGMENT_SHADER) &&
          "type must be a GL_VERTEX_SHADER or GL_FRAGMENT_SHADER");
+}
 
-  path p(ASSET_PREFIX);
-  p /= "shaders";
-  p /= filename;
-
-  try {
-    ifstream fin;
-    fin.exceptions(ios_base::badbit | ios_base::failbit);
-    fin.open(p, ios_base::in);
-    stringstream ss;
-    ss << fin.rdbuf();
-    string code = ss.str();
-    char const *codePtr = code.c_str();
-    glShaderSource(id, 1, &codePtr, nullptr);
-  } catch (ios_base::failure const &e) {
-    throw InitException("Failed to load shader " + filename.string(),
-                        "Could not read file " + filename.string());
-  }
+span<std::byte const> Shader::getSource() const noexcept { return source; }
+
+void Shader::compile() noexcept {
+  if (id != 0) return;
+  id = glCreateShader(type);
+
+  // compile straight out of the mapped asset pack
+  char const *code = reinterpret_cast<char const *>(source.data());
+  int length = static_cast<int>(source.size());
+  glShaderSource(id, 1, &code, &length);
 
   glCompileShader(id);
 
@@ -103,15 +107,25 @@ FragmentShader::FragmentShader(path const &filename)
     : Shader(GL_FRAGMENT_SHADER, filename) {}
 
 ShaderProgram::ShaderProgram(VertexShader &vs, FragmentShader &fs) noexcept
-    : GLResource(glCreateProgram()), uniforms() {
+    : GLResource(glCreateProgram()) {
+  uint64_t key = ShaderCache::key(vs.getSource(), fs.getSource());
+  if (shaderCache->load(id, key)) return;
+
+  vs.compile();
+  fs.compile();
+  glProgramParameteri(id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
   glAttachShader(id, vs.get());
   glAttachShader(id, fs.get());
   glLinkProgram(id);
+  glDetachShader(id, vs.get());
+  glDetachShader(id, fs.get());
 
-#ifndef NDEBUG
   int status;
   glGetProgramiv(id, GL_LINK_STATUS, &status);
-  if (status != GL_TRUE) {
+  if (status == GL_TRUE) {
+    shaderCache->store(id, key);
+  } else {
+#ifndef NDEBUG
     int length;
     glGetProgramiv(id, GL_INFO_LOG_LENGTH, &length);
     unique_ptr<char[]> log = make_unique<char[]>(length + 1);
@@ -119,162 +133,268 @@ ShaderProgram::ShaderProgram(VertexShader &vs, FragmentShader &fs) noexcept
     log[length] = '\0';
     cerr << "ERROR: Failed to link shaders" << endl;
     cerr << log.get() << endl;
-  }
 #endif
-
-  glDetachShader(id, vs.get());
-  glDetachShader(id, fs.get());
+  }
 }
 
 ShaderProgram::~ShaderProgram() noexcept {
-  if (id != 0) glDeleteProgram(id);
+  if (id != 0) {
+    renderState->forgetProgram(id);
+    glDeleteProgram(id);
+  }
 }
 
-void ShaderProgram::use() noexcept { glUseProgram(id); }
-
-ShaderProgram &ShaderProgram::setUniform(string const &name,
-                                         int value) noexcept {
-  assert([this]() {
-    unsigned currId;
-    glGetIntegerv(GL_CURRENT_PROGRAM, reinterpret_cast<int *>(&currId));
-    return currId == id;
-  }() && "active shader isn't the shader whose uniforms are being set");
-
-  glUniform1i(getUniformLocation(name), value);
+void ShaderProgram::use() noexcept { renderState->useProgram(id); }
 
-  return *this;
+template <>
+void Uniform<int>::set(int const &value) noexcept {
+  glProgramUniform1i(program, location, value);
 }
 
-ShaderProgram &ShaderProgram::setUniform(string const &name,
-                                         vec4 const &value) noexcept {
-  assert([this]() {
-    unsigned currId;
-    glGetIntegerv(GL_CURRENT_PROGRAM, reinterpret_cast<int *>(&currId));
-    return currId == id;
-  }() && "active shader isn't the shader whose uniforms are being set");
-
-  glUniform4fv(getUniformLocation(name), 1, value_ptr(value));
-
-  return *this;
+template <>
+void Uniform<vec4>::set(vec4 const &value) noexcept {
+  glProgramUniform4fv(program, location, 1, value_ptr(value));
 }
 
-ShaderProgram &ShaderProgram::setUniform(string const &name,
-                                         mat4 const &value) noexcept {
-  assert([this]() {
-    unsigned currId;
-    glGetIntegerv(GL_CURRENT_PROGRAM, reinterpret_cast<int *>(&currId));
-    return currId == id;
-  }() && "active shader isn't the shader whose uniforms are being set");
+template <>
+void Uniform<mat4>::set(mat4 const &value) noexcept {
+  glProgramUniformMatrix4fv(program, location, 1, false, value_ptr(value));
+}
 
-  glUniformMatrix4fv(getUniformLocation(name), 1, false, value_ptr(value));
+Texture2D::Texture2D(path const &filename) {
+  span<std::byte const> file = assets->get(path("textures") / filename);
+  if (!validCookedTexture(file))
+    throw InitException("Failed to load texture " + filename.string(),
+                        "Could not read file " + filename.string());
 
-  return *this;
+  *this = Texture2D(file, reinterpret_cast<uintptr_t>(file.data()));
 }
 
-int ShaderProgram::getUniformLocation(string const &name) noexcept {
-  unordered_map<string, int>::iterator found = uniforms.find(name);
-  if (found != uniforms.end()) {
-    return found->second;
-  } else {
-    assert((glGetUniformLocation(id, name.c_str()) != -1) &&
-           "name doesn't exist as a uniform in the shader program");
-    return uniforms[name] = glGetUniformLocation(id, name.c_str());
-  }
+Texture2D Texture2D::bc1(int width, int height,
+                         span<std::byte const> blocks) noexcept {
+  // a cooked header and level table whose level starts at blocks itself
+  std::byte cooked[sizeof(CookedTextureHeader) + sizeof(CookedTextureLevel)];
+  CookedTextureHeader header{{}, COOKED_TEXTURE_VERSION, TextureFormat::BC1,
+                             static_cast<uint32_t>(width),
+                             static_cast<uint32_t>(height), 1};
+  memcpy(header.magic, COOKED_TEXTURE_MAGIC, sizeof(COOKED_TEXTURE_MAGIC));
+  CookedTextureLevel level{static_cast<uint32_t>(width),
+                           static_cast<uint32_t>(height), 0, blocks.size()};
+  memcpy(cooked, &header, sizeof(header));
+  memcpy(cooked + sizeof(header), &level, sizeof(level));
+  return Texture2D(cooked, reinterpret_cast<uintptr_t>(blocks.data()));
 }
 
-Texture2D::Texture2D(path const &filename) {
-  glCreateTextures(GL_TEXTURE_2D, 1, &id);
-  glBindTexture(GL_TEXTURE_2D, id);
-
-  path p(ASSET_PREFIX);
-  p /= "textures";
-  p /= filename;
+Texture2D::Texture2D(span<std::byte const> cooked, uintptr_t base) noexcept {
+  CookedTextureHeader header;
+  memcpy(&header, cooked.data(), sizeof(header));
+
+  GLenum internalFormat;
+  GLenum format;
+  switch (header.format) {
+    case TextureFormat::RGBA8: {
+      internalFormat = GL_RGBA8;
+      format = GL_RGBA;
+      break;
+    }
+    case TextureFormat::R8: {
+      internalFormat = GL_R8;
+      format = GL_RED;
+      break;
+    }
+    case TextureFormat::BC1: {
+      internalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+      format = GL_RGB;
+      break;
+    }
+    case TextureFormat::BC3: {
+      internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+      format = GL_RGBA;
+      break;
+    }
+    case TextureFormat::BC4: {
+      internalFormat = GL_COMPRESSED_RED_RGTC1;
+      format = GL_RED;
+      break;
+    }
+  }
 
-  unique_ptr<uint8_t, void (*)(void *)> data(
-      stbi_load(p.c_str(), &width, &height, nullptr, 4), stbi_image_free);
-  if (!data)
-    throw InitException("Failed to load texture " + filename.string(),
-                        "Could not read file " + filename.string());
+  // without S3TC, BC1 and BC3 are decoded here, from the file rather than
+  // the PBO, and uploaded uncompressed
+  bool decode = (header.format == TextureFormat::BC1 ||
+                 header.format == TextureFormat::BC3) &&
+                !GLEW_EXT_texture_compression_s3tc;
+  uintptr_t source =
+      base != 0 ? base : reinterpret_cast<uintptr_t>(cooked.data());
+  vector<std::byte> decoded;
+  if (decode) {
+    internalFormat = GL_RGBA8;
+    format = GL_RGBA;
+    renderState->bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  }
 
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA,
-               GL_UNSIGNED_BYTE, data.get());
+  width = static_cast<int>(header.width);
+  height = static_cast<int>(header.height);
+  glCreateTextures(GL_TEXTURE_2D, 1, &id);
+  renderState->bindTexture(id);
+
+  glTexStorage2D(GL_TEXTURE_2D, static_cast<GLsizei>(header.levels),
+                 internalFormat, width, height);
+  for (uint32_t level = 0; level < header.levels; ++level) {
+    CookedTextureLevel info;
+    memcpy(&info,
+           cooked.data() + sizeof(CookedTextureHeader) +
+               level * sizeof(CookedTextureLevel),
+           sizeof(CookedTextureLevel));
+    void const *pixels = reinterpret_cast<void const *>(base + info.offset);
+    if (decode) {
+      decoded.resize(levelSize(TextureFormat::RGBA8, info.width, info.height));
+      decodeS3tc(header.format, info.width, info.height,
+                 span(reinterpret_cast<std::byte const *>(source + info.offset),
+                      info.size),
+                 decoded);
+      pixels = decoded.data();
+    }
+    if (isCompressed(header.format) && !decode)
+      glCompressedTexSubImage2D(
+          GL_TEXTURE_2D, static_cast<GLint>(level), 0, 0,
+          static_cast<GLsizei>(info.width), static_cast<GLsizei>(info.height),
+          internalFormat, static_cast<GLsizei>(info.size), pixels);
+    else
+      glTexSubImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), 0, 0,
+                      static_cast<GLsizei>(info.width),
+                      static_cast<GLsizei>(info.height), format,
+                      GL_UNSIGNED_BYTE, pixels);
+  }
 
-  glGenerateMipmap(GL_TEXTURE_2D);
+  // single-channel images are greyscale, not red
+  if (format == GL_RED) {
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_RED);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
+  }
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
-                  GL_LINEAR_MIPMAP_LINEAR);
+                  header.levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 }
 
-Texture2D::Texture2D(int width, int height, void const *pixels) noexcept
+Texture2D::Texture2D(int width, int height) noexcept
     : width(width), height(height) {
   glCreateTextures(GL_TEXTURE_2D, 1, &id);
-  glBindTexture(GL_TEXTURE_2D, id);
+  renderState->bindTexture(id);
 
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, width, height, 0, GL_RED,
-               GL_UNSIGNED_BYTE, pixels);
+  // starts blank - filtering at the edge of a glyph samples the padding
+  // around it, which is never written (glClearTexImage needs GL 4.4)
+  vector<GLubyte> blank(static_cast<size_t>(width) * height, 0);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width, height, 0, GL_RED,
+               GL_UNSIGNED_BYTE, blank.data());
 
-  glGenerateMipmap(GL_TEXTURE_2D);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
-                  GL_LINEAR_MIPMAP_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+}
+
+void Texture2D::update(int x, int y, int width, int height, int pitch,
+                       void const *pixels) noexcept {
+  renderState->bindTexture(id);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, pitch);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RED,
+                  GL_UNSIGNED_BYTE, pixels);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
 }
 
 Texture2D::~Texture2D() noexcept {
-  if (id != 0) glDeleteTextures(1, &id);
+  if (id != 0) {
+    renderState->forgetTexture(id);
+    glDeleteTextures(1, &id);
+  }
 }
 
 void Texture2D::use(GLenum textureNumber) noexcept {
-  glActiveTexture(textureNumber);
-  glBindTexture(GL_TEXTURE_2D, id);
+  renderState->bindTexture(textureNumber - GL_TEXTURE0, id);
 }
 
 int Texture2D::getWidth() const noexcept { return width; }
 
 int Texture2D::getHeight() const noexcept { return height; }
 
+// buffer uploads use direct state access so they never disturb the element
+// array binding of whichever VAO is currently bound
+
 VBO::VBO(vector<float> const &data, GLenum usage) noexcept
     : GLResource([]() {
         unsigned id;
-        glGenBuffers(1, &id);
+        glCreateBuffers(1, &id);
         return id;
       }()) {
-  use();
-  glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(float), data.data(),
-               usage);
+  glNamedBufferData(id, data.size() * sizeof(float), data.data(), usage);
 }
 
 VBO::~VBO() noexcept {
-  if (id != 0) glDeleteBuffers(1, &id);
+  if (id != 0) {
+    renderState->forgetBuffer(id);
+    glDeleteBuffers(1, &id);
+  }
 }
 
-void VBO::use() noexcept { glBindBuffer(GL_ARRAY_BUFFER, id); }
+void VBO::use() noexcept { renderState->bindBuffer(GL_ARRAY_BUFFER, id); }
 
 void VBO::update(vector<float> const &data, size_t offset) noexcept {
-  use();
-  glBufferSubData(GL_ARRAY_BUFFER, offset, data.size() * sizeof(float),
-                  data.data());
+  glNamedBufferSubData(id, offset, data.size() * sizeof(float), data.data());
+}
+
+void VBO::replace(vector<float> const &data, GLenum usage) noexcept {
+  glNamedBufferData(id, data.size() * sizeof(float), data.data(), usage);
+}
+
+PBO::PBO() noexcept
+    : GLResource([]() {
+        unsigned id;
+        glCreateBuffers(1, &id);
+        return id;
+      }()) {}
+
+PBO::~PBO() noexcept {
+  if (id != 0) {
+    renderState->forgetBuffer(id);
+    glDeleteBuffers(1, &id);
+  }
+}
+
+void PBO::use() noexcept {
+  renderState->bindBuffer(GL_PIXEL_UNPACK_BUFFER, id);
+}
+
+void PBO::upload(void const *data, size_t size) noexcept {
+  // orphan the previous contents so we never wait on an in-flight transfer
+  glNamedBufferData(id, size, nullptr, GL_STREAM_DRAW);
+  void *mapped = glMapNamedBufferRange(
+      id, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+  memcpy(mapped, data, size);
+  glUnmapNamedBuffer(id);
 }
 
 EBO::EBO(vector<unsigned> const &data, GLenum usage) noexcept
     : GLResource([]() {
         unsigned id;
-        glGenBuffers(1, &id);
+        glCreateBuffers(1, &id);
         return id;
       }()) {
-  use();
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, data.size() * sizeof(unsigned),
-               data.data(), usage);
+  glNamedBufferData(id, data.size() * sizeof(unsigned), data.data(), usage);
 }
 
 EBO::~EBO() noexcept {
-  if (id != 0) glDeleteBuffers(1, &id);
+  if (id != 0) {
+    renderState->forgetBuffer(id);
+    glDeleteBuffers(1, &id);
+  }
 }
 
-void EBO::use() noexcept { glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, id); }
+void EBO::use() noexcept {
+  renderState->bindBuffer(GL_ELEMENT_ARRAY_BUFFER, id);
+}
 
 VAO::VAO(VBO &vbo, EBO &ebo, vector<VAO::Attribute> const &attributes) noexcept
     : GLResource([]() {
@@ -282,7 +402,7 @@ VAO::VAO(VBO &vbo, EBO &ebo, vector<VAO::Attribute> const &attributes) noexcept
         glGenVertexArrays(1, &id);
         return id;
       }()) {
-  ScopeGuard guard = use();
+  Binding binding = use();
   vbo.use();
   ebo.use();
 
@@ -296,7 +416,10 @@ VAO::VAO(VBO &vbo, EBO &ebo, vector<VAO::Attribute> const &attributes) noexcept
 }
 
 VAO::~VAO() noexcept {
-  if (id != 0) glDeleteVertexArrays(1, &id);
+  if (id != 0) {
+    renderState->forgetVertexArray(id);
+    glDeleteVertexArrays(1, &id);
+  }
 }
 
 VAO::Attribute VAO::Attribute::floats(int size, int stride,
@@ -316,92 +439,230 @@ VAO::Attribute::Attribute(int size, GLenum type, bool normalized, int stride,
       stride(stride),
       offset(offset) {}
 
-ScopeGuard VAO::use() noexcept {
-  glBindVertexArray(id);
-  return ScopeGuard([]() { glBindVertexArray(0); });
+#ifndef NDEBUG
+VAO::Binding::Binding() noexcept : bound(true) {}
+
+VAO::Binding::Binding(Binding &&other) noexcept : bound(other.bound) {
+  other.bound = false;
+}
+
+VAO::Binding::~Binding() noexcept {
+  // debug builds unbind so stray buffer binds can't silently edit the VAO
+  if (bound) renderState->bindVertexArray(0);
+}
+
+VAO::Binding &VAO::Binding::operator=(Binding &&other) noexcept {
+  swap(bound, other.bound);
+  return *this;
 }
+#else
+VAO::Binding::Binding() noexcept = default;
+
+VAO::Binding::Binding(Binding &&) noexcept = default;
+
+VAO::Binding::~Binding() noexcept = default;
+
+VAO::Binding &VAO::Binding::operator=(Binding &&) noexcept = default;
+#endif
 
-void VAO::use(ScopeGuard &previous) noexcept {
-  previous.reset([]() { glBindVertexArray(0); });
-  glBindVertexArray(id);
+VAO::Binding VAO::use() noexcept {
+  renderState->bindVertexArray(id);
+  return Binding();
 }
 
-Glyph::Glyph(FT_GlyphSlot glyph) noexcept
-    : texture(glyph->bitmap.width, glyph->bitmap.rows, glyph->bitmap.buffer),
+GlyphAtlas::GlyphAtlas() noexcept : pages(), x(0), y(0), rowHeight(0) {}
+
+GlyphAtlas::Region GlyphAtlas::add(int width, int height, int pitch,
+                                   void const *pixels) noexcept {
+  assert((width + 2 * PADDING <= PAGE_SIZE &&
+          height + 2 * PADDING <= PAGE_SIZE) &&
+         "glyph is too large for an atlas page");
+
+  if (width == 0 || height == 0)
+    return Region{nullptr, 0.0f, 0.0f, 0.0f, 0.0f};
+
+  // shelf packing - start a new row, then a new page, when out of space
+  if (x + width + PADDING > PAGE_SIZE) {
+    x = 0;
+    y += rowHeight;
+    rowHeight = 0;
+  }
+  if (pages.empty() || y + height + PADDING > PAGE_SIZE) {
+    pages.push_back(
+        unique_ptr<Texture2D>(new Texture2D(PAGE_SIZE, PAGE_SIZE)));
+    x = 0;
+    y = 0;
+    rowHeight = 0;
+  }
+
+  int left = x + PADDING;
+  int top = y + PADDING;
+  Texture2D &page = *pages.back();
+  page.update(left, top, width, height, pitch, pixels);
+
+  x += width + PADDING;
+  rowHeight = std::max(rowHeight, height + PADDING);
+
+  return Region{&page, static_cast<float>(left) / PAGE_SIZE,
+                static_cast<float>(left + width) / PAGE_SIZE,
+                static_cast<float>(top) / PAGE_SIZE,
+                static_cast<float>(top + height) / PAGE_SIZE};
+}
+
+Glyph::Glyph(FT_GlyphSlot glyph, GlyphAtlas &atlas) noexcept
+    : region(atlas.add(glyph->bitmap.width, glyph->bitmap.rows,
+                       glyph->bitmap.pitch, glyph->bitmap.buffer)),
       xMin(glyph->bitmap_left),
       xMax(static_cast<float>(glyph->bitmap_left) + glyph->bitmap.width),
       yMin(static_cast<float>(glyph->bitmap_top) - glyph->bitmap.rows),
       yMax(glyph->bitmap_top),
-      advance(glyph->advance.x / 64) {}
+      advance(static_cast<float>(glyph->advance.x) / 64.0f) {}
+
+Glyph::Glyph(float advance_) noexcept
+    : region{nullptr, 0.0f, 0.0f, 0.0f, 0.0f},
+      xMin(0.0f),
+      xMax(0.0f),
+      yMin(0.0f),
+      yMax(0.0f),
+      advance(advance_) {}
+
+Glyph Glyph::scaled(float scale) const noexcept {
+  Glyph result = *this;
+  result.xMin *= scale;
+  result.xMax *= scale;
+  result.yMin *= scale;
+  result.yMax *= scale;
+  result.advance *= scale;
+  return result;
+}
 
-Font::Font() noexcept : face(nullptr, FT_Done_Face) {}
+Font::Font() noexcept
+    : face(nullptr, FT_Done_Face), size(0), cache(), atlas() {}
 
 Font::Font(path const &filename)
     : face(
           [&filename]() {
             FT_Face face;
-            path p(ASSET_PREFIX);
-            p /= filename;
+            span<std::byte const> file = assets->get(filename);
 
-            if (FT_New_Face(freetype->get(), p.c_str(), 0, &face) != FT_Err_Ok)
+            if (FT_New_Memory_Face(
+                    freetype->get(),
+                    reinterpret_cast<FT_Byte const *>(file.data()),
+                    static_cast<FT_Long>(file.size()), 0,
+                    &face) != FT_Err_Ok)
               throw InitException("Failed to load font " + filename.string(),
                                   "Could not read file " + filename.string());
+            FT_Set_Pixel_Sizes(face, 0, BASE_SIZE);
 
             return face;
           }(),
-          FT_Done_Face) {}
+          FT_Done_Face),
+      size(0),
+      cache(),
+      atlas() {}
 
 Font &Font::setSize(unsigned size) noexcept {
-  size = size;
-  FT_Set_Pixel_Sizes(face.get(), 0, size);
+  this->size = size;
   return *this;
 }
 
-Glyph &Font::glyph(char32_t c) const noexcept {
-  pair<unsigned, char32_t> key(size, c);
-  auto found = cache.find(key);
-  if (found != cache.end()) {
-    return found->second;
-  } else {
+Glyph Font::glyph(char32_t c) const noexcept {
+  auto found = cache.find(c);
+  if (found == cache.end()) {
+    // unhinted, since the outline is scaled after rasterization
 #ifndef NDEBUG
     FT_Error result =
 #endif
         FT_Load_Glyph(face.get(), FT_Get_Char_Index(face.get(), c),
-                      FT_LOAD_RENDER);
+                      FT_LOAD_NO_HINTING);
     assert((result == FT_Err_Ok) && "Failed to load glyph");
-    cache.emplace(key, Glyph(face.get()->glyph));
-    return cache.at(key);
+    FT_GlyphSlot slot = face.get()->glyph;
+    // outline-less glyphs (spaces) have no field, and render empty
+    FT_Error rendered = FT_Render_Glyph(slot, FT_RENDER_MODE_SDF);
+    // plain coverage stands in for a field that can't be made - its edge is
+    // at half coverage too, only blurrier once scaled
+    if (rendered != FT_Err_Ok)
+      rendered = FT_Render_Glyph(slot, FT_RENDER_MODE_NORMAL);
+    assert((rendered == FT_Err_Ok) && "Failed to render glyph");
+    found = cache
+                .emplace(c, rendered == FT_Err_Ok
+                                ? Glyph(slot, atlas)
+                                : Glyph(static_cast<float>(slot->advance.x) /
+                                        64.0f))
+                .first;
   }
+  return found->second.scaled(static_cast<float>(size) / BASE_SIZE);
 }
 
 ResourceManager::ResourceManager() noexcept
     : busyCursor(nullptr, SDL_FreeCursor),
-      arrowCursor(nullptr, SDL_FreeCursor) {}
+      arrowCursor(nullptr, SDL_FreeCursor),
+      loader(),
+      groups(),
+      prefetching(),
+      clock(0) {}
+
+ResourceManager::~ResourceManager() noexcept = default;
 
 void ResourceManager::loadSplash() {
-  splash = Texture2D("splash.tga");
-  backgroundVBO = VBO(
-      {
-          // position        // tex coord
-          -1.0f, -1.0f, /**/ 0.0f, 0.0f,  // bottom left
-          1.0f, -1.0f, /**/ 1.0f, 0.0f,   // bottom right
-          1.0f, 1.0f, /**/ 1.0f, 1.0f,    // top right
-          -1.0f, 1.0f, /**/ 0.0f, 1.0f,   // top left
-      },
-      GL_STATIC_DRAW);
-  quadEBO = EBO({0, 1, 2, 0, 2, 3}, GL_STATIC_DRAW);
-  quadAttributes = {
-      VAO::Attribute::floats(2, 4, 0),
-      VAO::Attribute::floats(2, 4, 2),
-  };
-  backgroundVAO = VAO(backgroundVBO, quadEBO, quadAttributes);
+  splash = Texture2D("splash.cctex");
   busyCursor.reset(SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_WAIT));
   image2Dv = make_unique<VertexShader>("image2D.v.glsl");
   FragmentShader image2Df("image2D.f.glsl");
   image2D = ShaderProgram(*image2Dv, image2Df);
+  image2D.uniform<int>("tex").set(0);
+
+  // 2D positions are given in screen space - (0, 0) is top left, (1, 1) is
+  // bottom right
+  view = UniformBuffer<ViewUniforms>(VIEW_BINDING);
+  view.update(ViewUniforms{ortho(0.0f, 1.0f, 1.0f, 0.0f)});
 }
 
 void ResourceManager::loadGame() {
+  // textures are read in from disk while fonts and shaders are set up
+  loader = make_unique<TextureLoader>();
+
+  // generic menu
+  loader->add(backOn, path("menu") / "backOn.cctex");
+  loader->add(backOff, path("menu") / "backOff.cctex");
+
+  loader->start();
+
+  // scenes load their own groups once they're entered
+  mainMenuResources = ResourceGroup({
+      {&mainMenuBackground, path("mainMenu") / "background.cctex"},
+      {&mainMenuTitle, path("mainMenu") / "title.cctex"},
+      {&newCampaignOn, path("mainMenu") / "newCampaignOn.cctex"},
+      {&newCampaignOff, path("mainMenu") / "newCampaignOff.cctex"},
+      {&loadCampaignOn, path("mainMenu") / "loadCampaignOn.cctex"},
+      {&loadCampaignOff, path("mainMenu") / "loadCampaignOff.cctex"},
+      {&optionsOn, path("mainMenu") / "optionsOn.cctex"},
+      {&optionsOff, path("mainMenu") / "optionsOff.cctex"},
+      {&quitOn, path("mainMenu") / "quitOn.cctex"},
+      {&quitOff, path("mainMenu") / "quitOff.cctex"},
+  });
+  newCampaignResources = ResourceGroup({
+      {&newCampaignBackground, path("newCampaign") / "background.cctex"},
+      {&newCampaignTitle, path("newCampaign") / "title.cctex"},
+      {&difficulty75On, path("newCampaign") / "difficulty75On.cctex"},
+      {&difficulty75Off, path("newCampaign") / "difficulty75Off.cctex"},
+      {&difficulty90On, path("newCampaign") / "difficulty90On.cctex"},
+      {&difficulty90Off, path("newCampaign") / "difficulty90Off.cctex"},
+      {&difficulty100On, path("newCampaign") / "difficulty100On.cctex"},
+      {&difficulty100Off, path("newCampaign") / "difficulty100Off.cctex"},
+      {&difficulty110On, path("newCampaign") / "difficulty110On.cctex"},
+      {&difficulty110Off, path("newCampaign") / "difficulty110Off.cctex"},
+      {&difficulty125On, path("newCampaign") / "difficulty125On.cctex"},
+      {&difficulty125Off, path("newCampaign") / "difficulty125Off.cctex"},
+  });
+  loadingResources = ResourceGroup({
+      {&loadingBackground, "loading.cctex"},
+  });
+  groups = {&mainMenuResources, &newCampaignResources, &loadingResources};
+
+  // the main menu is always shown first
+  mainMenuResources.readAhead();
+
   // post-splash
   arrowCursor.reset(SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_ARROW));
 
@@ -409,48 +670,80 @@ void ResourceManager::loadGame() {
   orbitron = Font("Orbitron.ttf");
   FragmentShader text2Df("text2D.f.glsl");
   text2D = ShaderProgram(*image2Dv, text2Df);
+  text2D.uniform<int>("tex").set(0);
   VertexShader solid2Dv("solid2D.v.glsl");
   FragmentShader solid2Df("solid2D.f.glsl");
   solid2D = ShaderProgram(solid2Dv, solid2Df);
-  cursorEBO = EBO({0, 1}, GL_STATIC_DRAW);
-  cursorAttributes = {VAO::Attribute::floats(2, 2, 0)};
-  backOn = Texture2D(path("menu") / "backOn.tga");
-  backOff = Texture2D(path("menu") / "backOff.tga");
-
-  // main menu
-  mainMenuBackground = Texture2D(path("mainMenu") / "background.tga");
-  mainMenuTitle = Texture2D(path("mainMenu") / "title.tga");
-  newCampaignOn = Texture2D(path("mainMenu") / "newCampaignOn.tga");
-  newCampaignOff = Texture2D(path("mainMenu") / "newCampaignOff.tga");
-  loadCampaignOn = Texture2D(path("mainMenu") / "loadCampaignOn.tga");
-  loadCampaignOff = Texture2D(path("mainMenu") / "loadCampaignOff.tga");
-  optionsOn = Texture2D(path("mainMenu") / "optionsOn.tga");
-  optionsOff = Texture2D(path("mainMenu") / "optionsOff.tga");
-  quitOn = Texture2D(path("mainMenu") / "quitOn.tga");
-  quitOff = Texture2D(path("mainMenu") / "quitOff.tga");
-
-  // new campaign
-  newCampaignBackground = Texture2D(path("newCampaign") / "background.tga");
-  newCampaignTitle = Texture2D(path("newCampaign") / "title.tga");
-  difficulty75On = Texture2D(path("newCampaign") / "difficulty75On.tga");
-  difficulty75Off = Texture2D(path("newCampaign") / "difficulty75Off.tga");
-  difficulty90On = Texture2D(path("newCampaign") / "difficulty90On.tga");
-  difficulty90Off = Texture2D(path("newCampaign") / "difficulty90Off.tga");
-  difficulty100On = Texture2D(path("newCampaign") / "difficulty100On.tga");
-  difficulty100Off = Texture2D(path("newCampaign") / "difficulty100Off.tga");
-  difficulty110On = Texture2D(path("newCampaign") / "difficulty110On.tga");
-  difficulty110Off = Texture2D(path("newCampaign") / "difficulty110Off.tga");
-  difficulty125On = Texture2D(path("newCampaign") / "difficulty125On.tga");
-  difficulty125Off = Texture2D(path("newCampaign") / "difficulty125Off.tga");
-
-  // options
-  optionsBackground = Texture2D(path("options") / "background.tga");
-
-  // loading
-  loadingBackground = Texture2D("loading.tga");
+
+  loader->finish();
 
   // clean up
   image2Dv.reset();
+  splash = Texture2D();  // never shown again
+}
+
+ResourceGroup::Pin ResourceManager::pin(ResourceGroup &group) noexcept {
+  ResourceGroup::Pin pinned(group);
+  group.lastUsed = ++clock;
+  prefetching.erase(remove(prefetching.begin(), prefetching.end(), &group),
+                    prefetching.end());
+
+  if (!group.isLoaded()) {
+    makeRoom(group.getPendingSize());
+    group.load(*loader, group.entries.size());
+  }
+  return pinned;
+}
+
+void ResourceManager::prefetch(ResourceGroup &group) noexcept {
+  if (group.isLoaded() || find(prefetching.begin(), prefetching.end(),
+                               &group) != prefetching.end())
+    return;
+
+  group.lastUsed = ++clock;
+  group.readAhead();
+  prefetching.push_back(&group);
+}
+
+void ResourceManager::pump() noexcept {
+  while (!prefetching.empty()) {
+    ResourceGroup &group = *prefetching.front();
+    if (group.isLoaded() ||
+        residentSize() + group.entries[group.loaded].file.size() >
+            size_t{options->vramBudget} << 20) {
+      // prefetching never evicts - that's left to pinning
+      prefetching.erase(prefetching.begin());
+      continue;
+    }
+
+    group.load(*loader, 1);
+    return;
+  }
+}
+
+size_t ResourceManager::residentSize() const noexcept {
+  size_t size = 0;
+  for (ResourceGroup const *group : groups) size += group->getResidentSize();
+  return size;
+}
+
+void ResourceManager::makeRoom(size_t size) noexcept {
+  size_t budget = size_t{options->vramBudget} << 20;
+  for (size_t resident = residentSize(); resident + size > budget;
+       resident = residentSize()) {
+    ResourceGroup *victim = nullptr;
+    for (ResourceGroup *group : groups)
+      if (!group->isPinned() && group->loaded != 0 &&
+          (victim == nullptr || group->lastUsed < victim->lastUsed))
+        victim = group;
+    // over budget with everything in use - allow it, rather than fail
+    if (victim == nullptr) return;
+
+    victim->evict();
+    prefetching.erase(
+        remove(prefetching.begin(), prefetching.end(), victim),
+        prefetching.end());
+  }
 }
 
 unique_ptr<ResourceManager> resources;
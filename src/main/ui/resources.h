@@ -23,8 +23,12 @@
 #include <GL/glew.h>
 #include <SDL2/SDL.h>
 
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -32,8 +36,7 @@
 
 #include "glm/glm.hpp"
 #include "ui/freetype.h"
-#include "util/pairHash.h"
-#include "util/scopeGuard.h"
+#include "ui/resourceGroup.h"
 
 namespace carrier_conquest::ui {
 class GLResource {
@@ -55,6 +58,7 @@ class GLResource {
   explicit GLResource(unsigned id) noexcept;
 };
 
+// shaders are only compiled if a program using them misses the shader cache
 class Shader : public GLResource {
  public:
   Shader() noexcept = default;
@@ -66,6 +70,14 @@ class Shader : public GLResource {
 
   Shader &operator=(Shader const &) noexcept = delete;
   Shader &operator=(Shader &&) noexcept = default;
+
+  std::span<std::byte const> getSource() const noexcept;
+  void compile() noexcept;
+
+ private:
+  GLenum type;
+  std::filesystem::path filename;
+  std::span<std::byte const> source;
 };
 
 class VertexShader final : public Shader {
@@ -94,6 +106,37 @@ class FragmentShader final : public Shader {
  private:
 };
 
+template <typename T>
+class Uniform final {
+  friend class ShaderProgram;
+
+ public:
+  Uniform() noexcept : program(0), location(-1) {}
+  Uniform(Uniform const &) noexcept = default;
+  Uniform(Uniform &&) noexcept = default;
+
+  ~Uniform() noexcept = default;
+
+  Uniform &operator=(Uniform const &) noexcept = default;
+  Uniform &operator=(Uniform &&) noexcept = default;
+
+  void set(T const &value) noexcept;
+
+ private:
+  unsigned program;
+  int location;
+
+  Uniform(unsigned program, int location) noexcept
+      : program(program), location(location) {}
+};
+
+template <>
+void Uniform<int>::set(int const &value) noexcept;
+template <>
+void Uniform<glm::vec4>::set(glm::vec4 const &value) noexcept;
+template <>
+void Uniform<glm::mat4>::set(glm::mat4 const &value) noexcept;
+
 class ShaderProgram final : public GLResource {
  public:
   ShaderProgram() noexcept = default;
@@ -108,25 +151,60 @@ class ShaderProgram final : public GLResource {
 
   void use() noexcept;
 
-  ShaderProgram &setUniform(std::string const &name, int value) noexcept;
-  ShaderProgram &setUniform(std::string const &name,
-                            glm::vec4 const &value) noexcept;
-  ShaderProgram &setUniform(std::string const &name,
-                            glm::mat4 const &value) noexcept;
+  template <typename T>
+  Uniform<T> uniform(char const *name) const noexcept {
+    int location = glGetUniformLocation(id, name);
+    assert((location != -1) &&
+           "name doesn't exist as a uniform in the shader program");
+    return Uniform<T>(id, location);
+  }
+};
 
- private:
-  std::unordered_map<std::string, int> uniforms;
+template <typename T>
+class UniformBuffer final : public GLResource {
+ public:
+  UniformBuffer() noexcept = default;
+  explicit UniformBuffer(unsigned binding) noexcept
+      : GLResource([]() {
+          unsigned id;
+          glCreateBuffers(1, &id);
+          return id;
+        }()) {
+    glNamedBufferStorage(id, sizeof(T), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    glBindBufferBase(GL_UNIFORM_BUFFER, binding, id);
+  }
+  UniformBuffer(UniformBuffer const &) noexcept = delete;
+  UniformBuffer(UniformBuffer &&) noexcept = default;
+
+  ~UniformBuffer() noexcept override {
+    if (id != 0) glDeleteBuffers(1, &id);
+  }
+
+  UniformBuffer &operator=(UniformBuffer const &) noexcept = delete;
+  UniformBuffer &operator=(UniformBuffer &&) noexcept = default;
+
+  void update(T const &value) noexcept {
+    glNamedBufferSubData(id, 0, sizeof(T), &value);
+  }
+};
 
-  int getUniformLocation(std::string const &name) noexcept;
+// std140 layout, shared by every 2D shader at binding point VIEW_BINDING
+struct ViewUniforms final {
+  glm::mat4 projection;
 };
 
-struct Glyph;
+class GlyphAtlas;
+class TextureLoader;
 class Texture2D final : public GLResource {
-  friend struct Glyph;
+  friend class GlyphAtlas;
+  friend class TextureLoader;
 
  public:
   Texture2D() noexcept = default;
   explicit Texture2D(std::filesystem::path const &filename);
+  // a single level of BC1 blocks from memory, bottom row first
+  static Texture2D bc1(int width, int height,
+                       std::span<std::byte const> blocks) noexcept;
   Texture2D(Texture2D const &) noexcept = delete;
   Texture2D(Texture2D &&) noexcept = default;
 
@@ -144,7 +222,14 @@ class Texture2D final : public GLResource {
   static constexpr float SCREEN_HEIGHT = 1080.0f;
 
  private:
-  Texture2D(int width, int height, void const *pixels) noexcept;
+  Texture2D(int width, int height) noexcept;
+  // levels are read from base plus their offset in the cooked file - base is
+  // either the file itself or zero, for a file staged in the bound PBO
+  // S3TC levels are decoded on the CPU if the driver can't sample them
+  Texture2D(std::span<std::byte const> cooked, uintptr_t base) noexcept;
+
+  void update(int x, int y, int width, int height, int pitch,
+              void const *pixels) noexcept;
 
   int width;
   int height;
@@ -165,6 +250,23 @@ class VBO final : public GLResource {
   void use() noexcept;
 
   void update(std::vector<float> const &data, size_t offset) noexcept;
+  void replace(std::vector<float> const &data, GLenum usage) noexcept;
+};
+
+class PBO final : public GLResource {
+ public:
+  PBO() noexcept;
+  PBO(PBO const &) noexcept = delete;
+  PBO(PBO &&) noexcept = default;
+
+  ~PBO() noexcept;
+
+  PBO &operator=(PBO const &) noexcept = delete;
+  PBO &operator=(PBO &&) noexcept = default;
+
+  void use() noexcept;
+
+  void upload(void const *data, size_t size) noexcept;
 };
 
 class EBO final : public GLResource {
@@ -207,6 +309,23 @@ class VAO final : public GLResource {
               int offset) noexcept;
   };
 
+  class Binding final {
+   public:
+    Binding() noexcept;
+    Binding(Binding const &) noexcept = delete;
+    Binding(Binding &&) noexcept;
+
+    ~Binding() noexcept;
+
+    Binding &operator=(Binding const &) noexcept = delete;
+    Binding &operator=(Binding &&) noexcept;
+
+#ifndef NDEBUG
+   private:
+    bool bound;
+#endif
+  };
+
   VAO() noexcept = default;
   VAO(VBO &, EBO &, std::vector<Attribute> const &) noexcept;
   VAO(VAO const &) noexcept = delete;
@@ -217,21 +336,60 @@ class VAO final : public GLResource {
   VAO &operator=(VAO const &) noexcept = delete;
   VAO &operator=(VAO &&) noexcept = default;
 
-  carrier_conquest::util::ScopeGuard use() noexcept;
-  void use(carrier_conquest::util::ScopeGuard &previous) noexcept;
+  Binding use() noexcept;
+};
+
+class GlyphAtlas final {
+ public:
+  struct Region final {
+    Texture2D *page;
+    float sMin;
+    float sMax;
+    float tMin;
+    float tMax;
+  };
+
+  GlyphAtlas() noexcept;
+  GlyphAtlas(GlyphAtlas const &) noexcept = delete;
+  GlyphAtlas(GlyphAtlas &&) noexcept = default;
+
+  ~GlyphAtlas() noexcept = default;
+
+  GlyphAtlas &operator=(GlyphAtlas const &) noexcept = delete;
+  GlyphAtlas &operator=(GlyphAtlas &&) noexcept = default;
+
+  Region add(int width, int height, int pitch, void const *pixels) noexcept;
+
+  static constexpr int PAGE_SIZE = 1024;
+
+ private:
+  std::vector<std::unique_ptr<Texture2D>> pages;
+  int x;
+  int y;
+  int rowHeight;
+
+  // blank texels around each glyph - the fields are drawn scaled, so
+  // filtering at an edge can reach more than one texel past it
+  static constexpr int PADDING = 2;
 };
 
+// metrics are in pixels; the region holds a signed distance field, so the
+// glyph can be drawn at any scale
 struct Glyph final {
-  explicit Glyph(FT_GlyphSlot glyph) noexcept;
-  Glyph(Glyph const &) noexcept = delete;
+  Glyph(FT_GlyphSlot glyph, GlyphAtlas &atlas) noexcept;
+  // draws nothing, but still takes up space
+  explicit Glyph(float advance) noexcept;
+  Glyph(Glyph const &) noexcept = default;
   Glyph(Glyph &&) noexcept = default;
 
   ~Glyph() noexcept = default;
 
-  Glyph &operator=(Glyph const &) noexcept = delete;
+  Glyph &operator=(Glyph const &) noexcept = default;
   Glyph &operator=(Glyph &&) noexcept = default;
 
-  Texture2D texture;
+  Glyph scaled(float scale) const noexcept;
+
+  GlyphAtlas::Region region;
   float xMin;
   float xMax;
   float yMin;
@@ -252,28 +410,28 @@ class Font final {
   Font &operator=(Font &&) noexcept = default;
 
   Font &setSize(unsigned size) noexcept;
-  Glyph &glyph(char32_t c) const noexcept;
+  // the glyph, scaled to the current size
+  Glyph glyph(char32_t c) const noexcept;
+
+  // size every glyph is rasterized at, once
+  static constexpr unsigned BASE_SIZE = 48;
 
  private:
   std::unique_ptr<std::remove_pointer<FT_Face>::type, decltype(&FT_Done_Face)>
       face;
   unsigned size;
-  std::unordered_map<
-      std::pair<char32_t, unsigned>, Glyph,
-      carrier_conquest::util::hash<unsigned, char32_t>> mutable cache;
+  std::unordered_map<char32_t, Glyph> mutable cache;
+  GlyphAtlas mutable atlas;
 };
 
 class ResourceManager final {
  public:
   // splash screen
+  UniformBuffer<ViewUniforms> view;
   ShaderProgram image2D;
 
   Texture2D splash;
 
-  VBO backgroundVBO;
-  EBO quadEBO;
-  std::vector<VAO::Attribute> quadAttributes;
-  VAO backgroundVAO;
   std::unique_ptr<SDL_Cursor, decltype(&SDL_FreeCursor)> busyCursor;
 
   // post-splash
@@ -283,8 +441,6 @@ class ResourceManager final {
   Font orbitron;
   ShaderProgram text2D;
   ShaderProgram solid2D;
-  EBO cursorEBO;
-  std::vector<VAO::Attribute> cursorAttributes;
   Texture2D backOn;
   Texture2D backOff;
 
@@ -321,11 +477,16 @@ class ResourceManager final {
   // loading
   Texture2D loadingBackground;
 
+  // per-scene groups of the above
+  ResourceGroup mainMenuResources;
+  ResourceGroup newCampaignResources;
+  ResourceGroup loadingResources;
+
   ResourceManager() noexcept;
   ResourceManager(ResourceManager const &) noexcept = delete;
   ResourceManager(ResourceManager &&) noexcept = delete;
 
-  ~ResourceManager() noexcept = default;
+  ~ResourceManager() noexcept;
 
   ResourceManager &operator=(ResourceManager const &) noexcept = delete;
   ResourceManager &operator=(ResourceManager &&) noexcept = delete;
@@ -333,9 +494,29 @@ class ResourceManager final {
   void loadSplash();
   void loadGame();
 
+  // loads a group, evicting groups that aren't in use to stay within the
+  // VRAM budget, and keeps it resident for the lifetime of the pin
+  // can't fail - a group's textures are checked when it's made, in loadGame
+  ResourceGroup::Pin pin(ResourceGroup &group) noexcept;
+  // uploads a group a texture at a time between frames, if it fits in the
+  // budget as it stands
+  void prefetch(ResourceGroup &group) noexcept;
+  // called once a frame to make progress on prefetches
+  void pump() noexcept;
+
+  static constexpr unsigned VIEW_BINDING = 0;
+
  private:
   // save between loads
   std::unique_ptr<VertexShader> image2Dv;
+
+  std::unique_ptr<TextureLoader> loader;
+  std::vector<ResourceGroup *> groups;
+  std::vector<ResourceGroup *> prefetching;
+  uint64_t clock;
+
+  size_t residentSize() const noexcept;
+  void makeRoom(size_t size) noexcept;
 };
 
 extern std::unique_ptr<ResourceManager> resources;
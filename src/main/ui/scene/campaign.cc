@@ -0,0 +1,167 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ui/scene/campaign.h"
+
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <variant>
+
+#include "game/game.h"
+#include "game/simulation.h"
+#include "ui/components.h"
+#include "ui/scene/mainMenu.h"
+#include "ui/window.h"
+
+using namespace carrier_conquest::game;
+using namespace std;
+using namespace std::chrono;
+using namespace glm;
+
+namespace carrier_conquest::ui::scene {
+namespace {
+vec4 const PLAYER_COLOUR(0.2f, 0.5f, 1.0f, 1.0f);
+vec4 const ENEMY_COLOUR(1.0f, 0.2f, 0.2f, 1.0f);
+vec4 const SELECTED_COLOUR(1.0f, 1.0f, 1.0f, 1.0f);
+}  // namespace
+
+class Campaign final {
+ public:
+  explicit Campaign(GameState &state) noexcept
+      : simulation(state), reportedFailures(0) {}
+  Campaign(Campaign const &) noexcept = delete;
+  Campaign(Campaign &&) noexcept = delete;
+
+  ~Campaign() noexcept = default;
+
+  Campaign &operator=(Campaign const &) noexcept = delete;
+  Campaign &operator=(Campaign &&) noexcept = delete;
+
+  Simulation simulation;
+
+  void draw() noexcept {
+    simulation.update();
+    Snapshot const &snapshot = simulation.getSnapshot();
+
+    // blend from the previous tick towards the latest as the next one nears
+    float sinceTick =
+        duration<float>(steady_clock::now() - snapshot.time).count();
+    float alpha = std::clamp(sinceTick / GameState::TICK_LENGTH, 0.0f, 1.0f);
+    for (Snapshot::Object const &object : snapshot.objects) {
+      if (!object.visible) continue;
+      float x = screenX(object, alpha);
+      float y = screenY(object, alpha);
+      if (object.selected) marker(x, y, SELECTED_SIZE, SELECTED_COLOUR);
+      marker(x, y, MARKER_SIZE,
+             object.side == Side::PLAYER ? PLAYER_COLOUR : ENEMY_COLOUR);
+    }
+  }
+
+  // the visible object under the cursor, or Entity::NONE
+  Entity pick(int32_t x, int32_t y) const noexcept {
+    Snapshot const &snapshot = simulation.getSnapshot();
+    for (Snapshot::Object const &object : snapshot.objects) {
+      if (!object.visible) continue;
+      float dx = screenX(object, 1.0f) * window->getWidth() - x;
+      float dy = screenY(object, 1.0f) * window->getHeight() - y;
+      if (std::abs(dx) <= MARKER_SIZE && std::abs(dy) <= MARKER_SIZE)
+        return object.entity;
+    }
+    return Entity::NONE;
+  }
+
+  // tells the player about each save that couldn't be written
+  void reportSaveFailures() noexcept {
+    Snapshot const &snapshot = simulation.getSnapshot();
+    if (snapshot.saveFailures == reportedFailures) return;
+    reportedFailures = snapshot.saveFailures;
+    SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Could not save game",
+                             snapshot.saveFailure.value_or("").c_str(),
+                             window->getWindow());
+  }
+
+ private:
+  uint32_t reportedFailures;
+
+  static constexpr float MARKER_SIZE = 3.0f;  // pixels
+  static constexpr float SELECTED_SIZE = 5.0f;
+
+  static float screenX(Snapshot::Object const &object, float alpha) noexcept {
+    return (object.previousX + (object.x - object.previousX) * alpha) /
+           GameState::MAP_SIZE;
+  }
+  static float screenY(Snapshot::Object const &object, float alpha) noexcept {
+    return (object.previousY + (object.y - object.previousY) * alpha) /
+           GameState::MAP_SIZE;
+  }
+
+  static void marker(float x, float y, float size,
+                     vec4 const &colour) noexcept {
+    float halfWidth = size / window->getWidth();
+    float halfHeight = size / window->getHeight();
+    sprites->draw(SpriteBatch::Layer::WIDGET, resources->solid2D, nullptr,
+                  {x - halfWidth, y + halfHeight, x + halfWidth,
+                   y - halfHeight},
+                  {0.0f, 0.0f, 0.0f, 0.0f}, colour);
+  }
+};
+
+NextScene campaign() noexcept {
+  Campaign campaign(*get<unique_ptr<GameState>>(gameState));
+
+  bool paused = false;
+  while (true) {
+    SDL_Event event;
+    // while paused, nothing changes until there's input, so sleep until then
+    bool hasEvent = paused ? SDL_WaitEvent(&event) != 0
+                           : SDL_PollEvent(&event) != 0;
+    for (; hasEvent; hasEvent = SDL_PollEvent(&event) != 0) {
+      switch (event.type) {
+        case SDL_QUIT: {
+          return nullopt;
+        }
+        case SDL_KEYDOWN: {
+          if (event.key.repeat != 0) break;
+          if (event.key.keysym.sym == SDLK_SPACE) {
+            paused = !paused;
+            campaign.simulation.setPaused(paused);
+          } else if (event.key.keysym.sym == SDLK_ESCAPE) {
+            return mainMenu;
+          }
+          break;
+        }
+        case SDL_MOUSEBUTTONUP: {
+          if (event.button.button == SDL_BUTTON_LEFT)
+            campaign.simulation.select(
+                campaign.pick(event.button.x, event.button.y));
+          break;
+        }
+      }
+    }
+
+    campaign.draw();
+    window->render();
+    campaign.reportSaveFailures();
+  }
+}
+}  // namespace carrier_conquest::ui::scene
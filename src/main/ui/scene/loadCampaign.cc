@@ -0,0 +1,244 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ui/scene/loadCampaign.h"
+
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "game/game.h"
+#include "game/saveIndex.h"
+#include "ui/components.h"
+#include "ui/scene/campaign.h"
+#include "ui/scene/loading.h"
+#include "ui/scene/mainMenu.h"
+#include "ui/window.h"
+#include "util/jobSystem.h"
+#include "util/overloaded.h"
+#include "util/paths.h"
+
+using namespace carrier_conquest::util;
+using namespace carrier_conquest::util::exceptions;
+using namespace std;
+using namespace std::filesystem;
+using namespace carrier_conquest::game;
+
+namespace carrier_conquest::ui::scene {
+namespace {
+// malformed sequences come out as U+FFFD
+u32string fromUtf8(string const &text) noexcept {
+  u32string decoded;
+  for (size_t idx = 0; idx < text.size();) {
+    unsigned char lead = static_cast<unsigned char>(text[idx++]);
+    size_t length = lead < 0x80   ? 0
+                    : lead < 0xc0 ? 4
+                    : lead < 0xe0 ? 1
+                    : lead < 0xf0 ? 2
+                    : lead < 0xf8 ? 3
+                                  : 4;
+    if (length == 4) {
+      decoded += U'\ufffd';
+      continue;
+    }
+    char32_t c = length == 0 ? lead : lead & (0x3f >> length);
+    for (; length > 0; --length) {
+      if (idx == text.size() || (text[idx] & 0xc0) != 0x80) {
+        c = U'\ufffd';
+        break;
+      }
+      c = c << 6 | (text[idx++] & 0x3f);
+    }
+    decoded += c;
+  }
+  return decoded;
+}
+
+u32string describe(SaveSummary const &summary) noexcept {
+  uint64_t seconds = static_cast<uint64_t>(
+      static_cast<double>(summary.ticks) * GameState::TICK_LENGTH);
+  time_t savedAt = static_cast<time_t>(summary.savedAt);
+  tm local;
+  localtime_r(&savedAt, &local);
+
+  stringstream ss;
+  ss << "Difficulty " << summary.difficulty << "% - " << seconds / 3600 << ":"
+     << setw(2) << setfill('0') << seconds / 60 % 60 << ":" << setw(2)
+     << setfill('0') << seconds % 60 << " played - saved "
+     << put_time(&local, "%Y-%m-%d %H:%M");
+  return fromUtf8(ss.str());
+}
+}  // namespace
+
+class LoadCampaign final {
+ public:
+  ButtonManager<Clickable> buttonManager;
+
+  LoadCampaign() noexcept
+      : buttonManager({}),
+        background(resources->mainMenuBackground),
+        back(Button2D::centered(resources->backOn, resources->backOff, 0.5f,
+                                layout(ROWS, ROWS + 1))),
+        saves(listSaves(getSavePath())),
+        first(0),
+        thumbnails(),
+        items() {
+    scroll(0);
+  }
+  LoadCampaign(LoadCampaign const &) noexcept = delete;
+  LoadCampaign(LoadCampaign &&) noexcept = delete;
+
+  ~LoadCampaign() noexcept = default;
+
+  LoadCampaign &operator=(LoadCampaign const &) noexcept = delete;
+  LoadCampaign &operator=(LoadCampaign &&) noexcept = delete;
+
+  void draw() noexcept {
+    background.draw();
+    for (ListItem2D &item : items) item.draw();
+    back.draw();
+  }
+
+  // moves the visible rows by delta, within the list
+  void scroll(ptrdiff_t delta) noexcept {
+    size_t last = saves.size() > ROWS ? saves.size() - ROWS : 0;
+    first = static_cast<size_t>(
+        clamp(static_cast<ptrdiff_t>(first) + delta, ptrdiff_t{0},
+              static_cast<ptrdiff_t>(last)));
+
+    // only the visible rows' thumbnails are uploaded
+    items.clear();
+    thumbnails.clear();
+    thumbnails.reserve(ROWS);
+    vector<reference_wrapper<Clickable>> clickables;
+    if (saves.empty()) {
+      items.push_back(ListItem2D::centered(resources->orbitron, nullptr,
+                                           U"No saved campaigns", U"", 0.5f,
+                                           layout(0, ROWS + 1)));
+    }
+    for (size_t row = 0; row < ROWS && first + row < saves.size(); ++row) {
+      SaveSummary const &summary = saves[first + row].summary;
+      thumbnails.push_back(thumbnail(summary));
+      items.push_back(ListItem2D::centered(
+          resources->orbitron,
+          thumbnails.back() ? &*thumbnails.back() : nullptr,
+          fromUtf8(string(summary.name,
+                          strnlen(summary.name, sizeof(summary.name)))),
+          describe(summary), 0.5f, layout(row, ROWS + 1)));
+    }
+    for (size_t row = 0; !saves.empty() && row < items.size(); ++row)
+      clickables.push_back(items[row]);
+    clickables.push_back(back);
+    buttonManager = ButtonManager<Clickable>(clickables);
+  }
+
+  // the save behind a clicked row, or nullopt for the back button
+  optional<path> selected(ptrdiff_t index) const noexcept {
+    if (saves.empty() || static_cast<size_t>(index) >= items.size())
+      return nullopt;
+    return saves[first + static_cast<size_t>(index)].filename;
+  }
+
+ private:
+  Background2D background;
+  Button2D back;
+  vector<SaveListing> saves;
+  size_t first;
+  // rows keep pointers to these, so room for every row is reserved up front
+  vector<optional<Texture2D>> thumbnails;
+  vector<ListItem2D> items;
+
+  static constexpr size_t ROWS = 6;
+
+  static optional<Texture2D> thumbnail(SaveSummary const &summary) noexcept {
+    if (summary.hasThumbnail == 0) return nullopt;
+    return Texture2D::bc1(THUMBNAIL_SIZE, THUMBNAIL_SIZE, summary.thumbnail);
+  }
+};
+
+NextScene loadCampaign() noexcept {
+  ResourceGroup::Pin pin = resources->pin(resources->mainMenuResources);
+  resources->prefetch(resources->loadingResources);
+  LoadCampaign loadCampaign;
+
+  while (true) {
+    SDL_Event event;
+    while (SDL_PollEvent(&event) != 0) {
+      switch (event.type) {
+        case SDL_QUIT: {
+          return nullopt;
+        }
+        case SDL_MOUSEWHEEL: {
+          loadCampaign.scroll(-event.wheel.y);
+          break;
+        }
+        case SDL_MOUSEBUTTONDOWN: {
+          if (event.button.button == SDL_BUTTON_LEFT)
+            loadCampaign.buttonManager.mouseDown(event.button.x,
+                                                 event.button.y);
+
+          break;
+        }
+        case SDL_MOUSEBUTTONUP: {
+          if (event.button.button != SDL_BUTTON_LEFT) break;
+          ptrdiff_t index = loadCampaign.buttonManager.mouseUp(event.button.x,
+                                                               event.button.y);
+          if (index == -1) break;
+          optional<path> filename = loadCampaign.selected(index);
+          if (!filename.has_value()) return mainMenu;
+          return loading(
+              jobs->submit([filename = *filename](stop_token const &token) {
+                GameState::load(token, filename);
+              }),
+              nullptr,
+              []() -> NextScene {
+                return visit(
+                    overloaded{
+                        [](unique_ptr<GameState> const &gameState)
+                            -> NextScene {
+                          return campaign;
+                        },
+                        [](LoadException const &exception) -> NextScene {
+                          // failed to load
+                          SDL_ShowSimpleMessageBox(
+                              SDL_MESSAGEBOX_ERROR,
+                              exception.getTitle().c_str(),
+                              exception.getMessage().c_str(),
+                              window->getWindow());
+                          return scene::loadCampaign;
+                        }},
+                    gameState);
+              });
+        }
+      }
+    }
+
+    loadCampaign.draw();
+    window->render();
+  }
+}
+}  // namespace carrier_conquest::ui::scene
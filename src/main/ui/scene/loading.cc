@@ -21,13 +21,21 @@
 
 #include <SDL2/SDL.h>
 
+#include <memory>
+
 #include "ui/components.h"
 #include "ui/window.h"
 
 using namespace carrier_conquest::util;
 using namespace std;
+using namespace glm;
 
 namespace carrier_conquest::ui::scene {
+namespace {
+vec4 const BAR_BACKGROUND(0.0f, 0.0f, 0.0f, 0.5f);
+vec4 const BAR_COLOUR(1.0f, 1.0f, 1.0f, 1.0f);
+}  // namespace
+
 class Loading final {
  public:
   Loading() noexcept : background(resources->loadingBackground) {}
@@ -39,13 +47,32 @@ class Loading final {
   Loading &operator=(Loading const &) noexcept = delete;
   Loading &operator=(Loading &&) noexcept = delete;
 
-  void draw() noexcept { background.draw(); }
+  void draw(Progress const *progress) noexcept {
+    background.draw();
+    if (progress == nullptr) return;
+
+    float fill = BAR_LEFT + (BAR_RIGHT - BAR_LEFT) * progress->get();
+    sprites->draw(SpriteBatch::Layer::WIDGET, resources->solid2D, nullptr,
+                  {BAR_LEFT, BAR_BOTTOM, BAR_RIGHT, BAR_TOP},
+                  {0.0f, 0.0f, 0.0f, 0.0f}, BAR_BACKGROUND);
+    sprites->draw(SpriteBatch::Layer::OVERLAY, resources->solid2D, nullptr,
+                  {BAR_LEFT, BAR_BOTTOM, fill, BAR_TOP},
+                  {0.0f, 0.0f, 0.0f, 0.0f}, BAR_COLOUR);
+  }
 
  private:
   Background2D background;
+
+  // screen fractions
+  static constexpr float BAR_LEFT = 0.25f;
+  static constexpr float BAR_RIGHT = 0.75f;
+  static constexpr float BAR_TOP = 0.85f;
+  static constexpr float BAR_BOTTOM = 0.87f;
 };
 
-NextScene loading(LoadingThread loader, NextScene next) noexcept {
+NextScene loading(JobSystem::Handle job, shared_ptr<Progress const> progress,
+                  NextScene next) noexcept {
+  ResourceGroup::Pin pin = resources->pin(resources->loadingResources);
   Loading loading;
 
   while (true) {
@@ -53,16 +80,18 @@ NextScene loading(LoadingThread loader, NextScene next) noexcept {
     while (SDL_PollEvent(&event) != 0) {
       switch (event.type) {
         case SDL_QUIT: {
+          job->cancel();
+          jobs->wait(job);
           return nullopt;
         }
       }
     }
 
-    if (!loader.isRunning()) {
+    if (job->isDone()) {
       return next;
     }
 
-    loading.draw();
+    loading.draw(progress.get());
     window->render();
   }
 }
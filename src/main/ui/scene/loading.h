@@ -20,11 +20,18 @@
 #ifndef CARRIERCONQUEST_UI_SCENE_LOADING_H_
 #define CARRIERCONQUEST_UI_SCENE_LOADING_H_
 
+#include <memory>
+
 #include "ui/scene/scene.h"
-#include "util/loadingThread.h"
+#include "util/jobSystem.h"
+#include "util/progress.h"
 
 namespace carrier_conquest::ui::scene {
-NextScene loading(util::LoadingThread loader, NextScene next) noexcept;
+// shows the loading screen until job is done, then goes to next - with a
+// progress bar, if given progress to show
+NextScene loading(util::JobSystem::Handle job,
+                  std::shared_ptr<util::Progress const> progress,
+                  NextScene next) noexcept;
 }
 
 #endif  // CARRIERCONQUEST_UI_SCENE_LOADING_H_
@@ -21,19 +21,12 @@
 
 #include <SDL2/SDL.h>
 
-#include <memory>
-
-#include "game/game.h"
 #include "ui/components.h"
-#include "ui/scene/loading.h"
+#include "ui/scene/loadCampaign.h"
 #include "ui/scene/newCampaign.h"
 #include "ui/window.h"
-#include "util/overloaded.h"
 
-using namespace carrier_conquest::util;
-using namespace carrier_conquest::util::exceptions;
 using namespace std;
-using namespace carrier_conquest::game;
 
 namespace carrier_conquest::ui::scene {
 class MainMenu final {
@@ -81,6 +74,8 @@ class MainMenu final {
 };
 
 NextScene mainMenu() noexcept {
+  ResourceGroup::Pin pin = resources->pin(resources->mainMenuResources);
+  resources->prefetch(resources->newCampaignResources);
   MainMenu mainMenu;
 
   while (true) {
@@ -106,29 +101,7 @@ NextScene mainMenu() noexcept {
               }
               case 1: {
                 // load campaign
-                return loading(
-                    LoadingThread([](stop_token const &token) {
-                      GameState::load(token);
-                    }),
-                    []() -> NextScene {
-                      return visit(
-                          overloaded{
-                              [](unique_ptr<GameState> const &gameState)
-                                  -> NextScene {
-                                // TODO: start playing
-                                return nullopt;
-                              },
-                              [](LoadException const &exception) -> NextScene {
-                                // failed to load
-                                SDL_ShowSimpleMessageBox(
-                                    SDL_MESSAGEBOX_ERROR,
-                                    exception.getTitle().c_str(),
-                                    exception.getMessage().c_str(),
-                                    window->getWindow());
-                                return newCampaign;
-                              }},
-                          gameState);
-                    });
+                return loadCampaign;
               }
               case 2: {
                 // options
@@ -22,13 +22,15 @@
 #include <SDL2/SDL.h>
 
 #include <memory>
+#include <random>
 
 #include "game/game.h"
 #include "ui/components.h"
+#include "ui/scene/campaign.h"
 #include "ui/scene/loading.h"
 #include "ui/scene/mainMenu.h"
 #include "ui/window.h"
-#include "util/loadingThread.h"
+#include "util/jobSystem.h"
 #include "util/overloaded.h"
 
 using namespace carrier_conquest::util;
@@ -97,6 +99,8 @@ class NewCampaign final {
 constexpr array<uint32_t, 5> DIFFICULTIES = {75, 90, 100, 110, 125};
 
 NextScene newCampaign() noexcept {
+  ResourceGroup::Pin pin = resources->pin(resources->newCampaignResources);
+  resources->prefetch(resources->loadingResources);
   NewCampaign newCampaign;
   while (true) {
     SDL_Event event;
@@ -121,18 +125,22 @@ NextScene newCampaign() noexcept {
               case 3:
               case 4: {
                 // new campaign with specified difficulty
+                shared_ptr<Progress> progress = make_shared<Progress>();
+                random_device device;
+                uint64_t seed = uint64_t{device()} << 32 | device();
                 return loading(
-                    LoadingThread([index](stop_token const &token) {
-                      GameState::generate(token, DIFFICULTIES[index]);
-                      GameState::load(token);
-                    }),
+                    jobs->submit(
+                        [index, seed, progress](stop_token const &token) {
+                          GameState::generate(token, DIFFICULTIES[index], seed,
+                                              *progress);
+                        }),
+                    progress,
                     []() -> NextScene {
                       return visit(
                           overloaded{
                               [](unique_ptr<GameState> const &gameState)
                                   -> NextScene {
-                                // TODO: start playing
-                                return nullopt;
+                                return campaign;
                               },
                               [](LoadException const &exception) -> NextScene {
                                 // failed to load
@@ -0,0 +1,165 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ui/shaderCache.h"
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include "util/paths.h"
+
+using namespace std;
+using namespace std::filesystem;
+using namespace carrier_conquest::util;
+
+namespace carrier_conquest::ui {
+namespace {
+// FNV-1a
+uint64_t hashBytes(span<std::byte const> bytes, uint64_t hash) noexcept {
+  for (std::byte b : bytes) {
+    hash ^= static_cast<uint64_t>(b);
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+string glString(GLenum name) noexcept {
+  char const *value = reinterpret_cast<char const *>(glGetString(name));
+  return value == nullptr ? string() : string(value);
+}
+}  // namespace
+
+ShaderCache::ShaderCache() noexcept
+    : enabled(false),
+      driver(glString(GL_VENDOR) + '\n' + glString(GL_RENDERER) + '\n' +
+             glString(GL_VERSION)),
+      directory() {
+  int formats = 0;
+  glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+  if (formats == 0) return;
+
+  try {
+    directory = getSavePath() / "shaderCache";
+    create_directories(directory);
+    enabled = true;
+  } catch (...) {
+    // no cache - every program gets linked from source
+  }
+}
+
+uint64_t ShaderCache::key(span<std::byte const> vertexSource,
+                          span<std::byte const> fragmentSource) noexcept {
+  // the separator keeps sources that split differently from colliding
+  std::byte const separator[1] = {std::byte{0}};
+  uint64_t hash = hashBytes(vertexSource, 0xcbf29ce484222325ull);
+  hash = hashBytes(separator, hash);
+  return hashBytes(fragmentSource, hash);
+}
+
+bool ShaderCache::load(unsigned program, uint64_t key) const noexcept {
+  if (!enabled) return false;
+
+  try {
+    ifstream fin(filename(key), ios_base::in | ios_base::binary);
+    if (!fin) return false;
+    fin.seekg(0, ios_base::end);
+    size_t size = static_cast<size_t>(fin.tellg());
+    fin.seekg(0, ios_base::beg);
+
+    Header header;
+    if (size < sizeof(Header) ||
+        !fin.read(reinterpret_cast<char *>(&header), sizeof(Header)))
+      return false;
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        header.version != VERSION || header.key != key ||
+        header.driverLength != driver.size() ||
+        size < sizeof(Header) + header.driverLength)
+      return false;
+
+    string cachedDriver(header.driverLength, '\0');
+    if (!fin.read(cachedDriver.data(),
+                  static_cast<streamsize>(cachedDriver.size())) ||
+        cachedDriver != driver)
+      return false;
+
+    vector<char> binary(size - sizeof(Header) - header.driverLength);
+    if (!fin.read(binary.data(), static_cast<streamsize>(binary.size())))
+      return false;
+
+    glProgramBinary(program, header.format, binary.data(),
+                    static_cast<GLsizei>(binary.size()));
+    int status;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    return status == GL_TRUE;
+  } catch (...) {
+    return false;
+  }
+}
+
+void ShaderCache::store(unsigned program, uint64_t key) const noexcept {
+  if (!enabled) return;
+
+  int length = 0;
+  glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0) return;
+
+  try {
+    vector<char> binary(static_cast<size_t>(length));
+    GLenum format;
+    glGetProgramBinary(program, length, &length, &format, binary.data());
+
+    Header header;
+    copy(begin(MAGIC), end(MAGIC), header.magic);
+    header.version = VERSION;
+    header.key = key;
+    header.format = format;
+    header.driverLength = static_cast<uint32_t>(driver.size());
+
+    // write then rename, so a crash never leaves a truncated binary behind
+    path target = filename(key);
+    path temporary = target;
+    temporary += ".tmp";
+    {
+      ofstream fout;
+      fout.exceptions(ofstream::failbit | ofstream::badbit);
+      fout.open(temporary, ios_base::out | ios_base::binary | ios_base::trunc);
+      fout.write(reinterpret_cast<char const *>(&header), sizeof(Header));
+      fout.write(driver.data(), static_cast<streamsize>(driver.size()));
+      fout.write(binary.data(), length);
+    }
+    rename(temporary, target);
+  } catch (...) {
+    // a missing cache entry only costs a relink next launch
+  }
+}
+
+path ShaderCache::filename(uint64_t key) const {
+  stringstream ss;
+  ss << hex << setw(16) << setfill('0') << key << ".bin";
+  return directory / ss.str();
+}
+
+unique_ptr<ShaderCache> shaderCache;
+}  // namespace carrier_conquest::ui
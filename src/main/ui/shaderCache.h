@@ -0,0 +1,74 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_UI_SHADERCACHE_H_
+#define CARRIERCONQUEST_UI_SHADERCACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+
+namespace carrier_conquest::ui {
+// on-disk cache of linked program binaries, one file per combination of
+// shader sources, stamped with the driver that produced it
+class ShaderCache final {
+ public:
+  ShaderCache() noexcept;
+  ShaderCache(ShaderCache const &) noexcept = delete;
+  ShaderCache(ShaderCache &&) noexcept = delete;
+
+  ~ShaderCache() noexcept = default;
+
+  ShaderCache &operator=(ShaderCache const &) noexcept = delete;
+  ShaderCache &operator=(ShaderCache &&) noexcept = delete;
+
+  static uint64_t key(std::span<std::byte const> vertexSource,
+                      std::span<std::byte const> fragmentSource) noexcept;
+
+  // loads the cached binary into program, returning false if there is no
+  // usable binary and the program must be linked from source
+  bool load(unsigned program, uint64_t key) const noexcept;
+  void store(unsigned program, uint64_t key) const noexcept;
+
+ private:
+  struct Header final {
+    char magic[4];
+    uint32_t version;
+    uint64_t key;
+    uint32_t format;
+    uint32_t driverLength;
+  };
+
+  bool enabled;
+  std::string driver;
+  std::filesystem::path directory;
+
+  static constexpr char MAGIC[4] = {'C', 'C', 'S', 'C'};
+  static constexpr uint32_t VERSION = 1;
+
+  std::filesystem::path filename(uint64_t key) const;
+};
+
+extern std::unique_ptr<ShaderCache> shaderCache;
+}  // namespace carrier_conquest::ui
+
+#endif  // CARRIERCONQUEST_UI_SHADERCACHE_H_
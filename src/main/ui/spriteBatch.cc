@@ -0,0 +1,135 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ui/spriteBatch.h"
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+using namespace std;
+using namespace glm;
+
+namespace carrier_conquest::ui {
+SpriteBatch::SpriteBatch() noexcept
+    : commands(),
+      vertices(),
+      sorted(),
+      vbo(vector<float>(), GL_STREAM_DRAW),
+      ebo(
+          []() {
+            vector<unsigned> indices;
+            indices.reserve(MAX_QUADS * 6);
+            for (unsigned quad = 0; quad < MAX_QUADS; ++quad) {
+              unsigned base = quad * 4;
+              indices.insert(indices.end(), {base + 0, base + 1, base + 2,
+                                             base + 0, base + 2, base + 3});
+            }
+            return indices;
+          }(),
+          GL_STATIC_DRAW),
+      vao(vbo, ebo,
+          {
+              VAO::Attribute::floats(2, VERTEX_SIZE, 0),
+              VAO::Attribute::floats(2, VERTEX_SIZE, 2),
+              VAO::Attribute::floats(4, VERTEX_SIZE, 4),
+          }) {}
+
+void SpriteBatch::draw(Layer layer, ShaderProgram &program, Texture2D *texture,
+                       Rect const &pos, Rect const &tex,
+                       vec4 const &colour) noexcept {
+  commands.push_back(Command{layer, &program, texture, vertices.size()});
+  vertices.insert(vertices.end(),
+                  {
+                      pos.left, pos.bottom,                    // bottom left
+                      tex.left, tex.bottom,
+                      colour.r, colour.g, colour.b, colour.a,
+                      pos.right, pos.bottom,                   // bottom right
+                      tex.right, tex.bottom,
+                      colour.r, colour.g, colour.b, colour.a,
+                      pos.right, pos.top,                      // top right
+                      tex.right, tex.top,
+                      colour.r, colour.g, colour.b, colour.a,
+                      pos.left, pos.top,                       // top left
+                      tex.left, tex.top,
+                      colour.r, colour.g, colour.b, colour.a,
+                  });
+}
+
+void SpriteBatch::draw(Layer layer, Texture2D &texture,
+                       Rect const &pos) noexcept {
+  draw(layer, resources->image2D, &texture, pos, {0.0f, 0.0f, 1.0f, 1.0f},
+       {1.0f, 1.0f, 1.0f, 1.0f});
+}
+
+void SpriteBatch::flush() noexcept {
+  if (commands.empty()) return;
+
+  // painter's order is only kept between layers - within a layer, group by
+  // state so each program/texture pair is drawn once
+  // vertex breaks ties in submission order, as stable_sort would, without
+  // stable_sort's temporary buffer every frame
+  // the pointers are unrelated objects, so they're ordered with less, which
+  // is total where < isn't
+  sort(commands.begin(), commands.end(),
+       [](Command const &a, Command const &b) {
+         less<> before;
+         if (a.layer != b.layer) return a.layer < b.layer;
+         if (a.program != b.program) return before(a.program, b.program);
+         if (a.texture != b.texture) return before(a.texture, b.texture);
+         return a.vertex < b.vertex;
+       });
+  sorted.clear();
+  for (Command const &command : commands)
+    sorted.insert(sorted.end(), vertices.begin() + command.vertex,
+                  vertices.begin() + command.vertex + QUAD_SIZE);
+  vbo.replace(sorted, GL_STREAM_DRAW);
+
+  VAO::Binding binding = vao.use();
+  ShaderProgram *program = nullptr;
+  Texture2D *texture = nullptr;
+  for (size_t start = 0; start < commands.size();) {
+    Command const &first = commands[start];
+    size_t end = start + 1;
+    while (end < commands.size() && end - start < MAX_QUADS &&
+           commands[end].program == first.program &&
+           commands[end].texture == first.texture)
+      ++end;
+
+    if (program != first.program) {
+      program = first.program;
+      program->use();
+    }
+    if (texture != first.texture && first.texture != nullptr) {
+      texture = first.texture;
+      texture->use(GL_TEXTURE0);
+    }
+    glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<int>(end - start) * 6,
+                             GL_UNSIGNED_INT, nullptr,
+                             static_cast<int>(start * 4));
+
+    start = end;
+  }
+
+  commands.clear();
+  vertices.clear();
+}
+
+unique_ptr<SpriteBatch> sprites;
+}  // namespace carrier_conquest::ui
@@ -0,0 +1,81 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_UI_SPRITEBATCH_H_
+#define CARRIERCONQUEST_UI_SPRITEBATCH_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "glm/glm.hpp"
+#include "ui/resources.h"
+
+namespace carrier_conquest::ui {
+class SpriteBatch final {
+ public:
+  enum class Layer : uint8_t { BACKGROUND, WIDGET, TEXT, OVERLAY };
+
+  struct Rect final {
+    float left;
+    float bottom;
+    float right;
+    float top;
+  };
+
+  SpriteBatch() noexcept;
+  SpriteBatch(SpriteBatch const &) noexcept = delete;
+  SpriteBatch(SpriteBatch &&) noexcept = delete;
+
+  ~SpriteBatch() noexcept = default;
+
+  SpriteBatch &operator=(SpriteBatch const &) noexcept = delete;
+  SpriteBatch &operator=(SpriteBatch &&) noexcept = delete;
+
+  void draw(Layer layer, ShaderProgram &program, Texture2D *texture,
+            Rect const &position, Rect const &texCoord,
+            glm::vec4 const &colour) noexcept;
+  void draw(Layer layer, Texture2D &texture, Rect const &position) noexcept;
+  void flush() noexcept;
+
+  static constexpr size_t MAX_QUADS = 4096;
+
+ private:
+  struct Command final {
+    Layer layer;
+    ShaderProgram *program;
+    Texture2D *texture;
+    size_t vertex;
+  };
+
+  std::vector<Command> commands;
+  std::vector<float> vertices;
+  std::vector<float> sorted;
+  VBO vbo;
+  EBO ebo;
+  VAO vao;
+
+  static constexpr size_t VERTEX_SIZE = 8;
+  static constexpr size_t QUAD_SIZE = 4 * VERTEX_SIZE;
+};
+
+extern std::unique_ptr<SpriteBatch> sprites;
+}  // namespace carrier_conquest::ui
+
+#endif  // CARRIERCONQUEST_UI_SPRITEBATCH_H_
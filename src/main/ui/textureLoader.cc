@@ -0,0 +1,59 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ui/textureLoader.h"
+
+#include "ui/renderState.h"
+#include "util/assetPack.h"
+#include "util/cookedTexture.h"
+#include "util/exceptions/initException.h"
+
+using namespace std;
+using namespace std::filesystem;
+using namespace carrier_conquest::util::exceptions;
+using namespace carrier_conquest::util;
+
+namespace carrier_conquest::ui {
+TextureLoader::TextureLoader() noexcept : jobs(), pbo() {}
+
+void TextureLoader::add(Texture2D &texture, path const &filename) {
+  span<std::byte const> file = assets->get(path("textures") / filename);
+  if (!validCookedTexture(file))
+    throw InitException("Failed to load texture " + filename.string(),
+                        "Could not read file " + filename.string());
+  jobs.push_back(Job{&texture, file});
+}
+
+void TextureLoader::start() noexcept {
+  for (Job const &job : jobs) assets->prefetch(job.file);
+}
+
+void TextureLoader::finish() noexcept {
+  for (Job &job : jobs) {
+    // cooked files are upload-ready, so the whole file goes into the pixel
+    // buffer and each level is read from its offset within it
+    pbo.upload(job.file.data(), job.file.size());
+    pbo.use();
+    *job.texture = Texture2D(job.file, 0);
+  }
+  renderState->bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+  jobs.clear();
+}
+}  // namespace carrier_conquest::ui
@@ -0,0 +1,60 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_UI_TEXTURELOADER_H_
+#define CARRIERCONQUEST_UI_TEXTURELOADER_H_
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include "ui/resources.h"
+
+namespace carrier_conquest::ui {
+// loads a batch of cooked textures - start() begins reading them in from disk,
+// finish() stages each one through a pixel buffer and uploads it
+class TextureLoader final {
+ public:
+  TextureLoader() noexcept;
+  TextureLoader(TextureLoader const &) noexcept = delete;
+  TextureLoader(TextureLoader &&) noexcept = delete;
+
+  ~TextureLoader() noexcept = default;
+
+  TextureLoader &operator=(TextureLoader const &) noexcept = delete;
+  TextureLoader &operator=(TextureLoader &&) noexcept = delete;
+
+  void add(Texture2D &texture, std::filesystem::path const &filename);
+
+  void start() noexcept;
+  void finish() noexcept;
+
+ private:
+  struct Job final {
+    Texture2D *texture;
+    std::span<std::byte const> file;
+  };
+
+  std::vector<Job> jobs;
+  PBO pbo;
+};
+}  // namespace carrier_conquest::ui
+
+#endif  // CARRIERCONQUEST_UI_TEXTURELOADER_H_
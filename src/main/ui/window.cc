@@ -24,9 +24,14 @@
 #include <iostream>
 
 #include "options.h"
+#include "ui/renderState.h"
 #include "ui/resources.h"
+#include "ui/spriteBatch.h"
+#include "util/arena.h"
 #include "util/exceptions/initException.h"
+#include "util/jobSystem.h"
 
+using namespace carrier_conquest::util;
 using namespace carrier_conquest::util::exceptions;
 using namespace std;
 
@@ -195,6 +200,9 @@ Window::Window()
 
   glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
+  glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+  glClear(GL_COLOR_BUFFER_BIT);
+
 #ifndef NDEBUG
   glEnable(GL_DEBUG_OUTPUT);
   glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
@@ -203,11 +211,23 @@ Window::Window()
 }
 
 Window::~Window() noexcept {
-  resources.reset();  // avoid static deinit order fiasco
+  sprites.reset();  // avoid static deinit order fiasco
+  resources.reset();
+  renderState.reset();
   SDL_Quit();
 }
 
-void Window::render() noexcept { SDL_GL_SwapWindow(window.get()); }
+void Window::render() noexcept {
+  sprites->flush();
+  SDL_GL_SwapWindow(window.get());
+  // the back buffer is undefined after a swap, and not every scene covers it
+  glClear(GL_COLOR_BUFFER_BIT);
+  renderState->endFrame();
+  resources->pump();
+  jobs->runMainThread();
+  // anything the frame left in the main thread's scratch arena is done with
+  threadArena().reset();
+}
 
 SDL_Window *Window::getWindow() noexcept { return window.get(); }
 int Window::getWidth() const noexcept { return width; }
@@ -36,6 +36,9 @@ class Window final {
   Window &operator=(Window const &) noexcept = delete;
   Window &operator=(Window &&) noexcept = delete;
 
+  // presents the frame and clears the next, then resets the main thread's
+  // scratch arena, which makes it the per-frame arena - don't call from
+  // inside one of its scopes
   void render() noexcept;
 
   SDL_Window *getWindow() noexcept;
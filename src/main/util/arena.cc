@@ -0,0 +1,135 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "util/arena.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <mutex>
+
+using namespace std;
+
+namespace carrier_conquest::util {
+namespace {
+mutex registryMutex;
+vector<Arena const *> registry;  // every live thread's scratch arena
+
+struct ThreadArena final {
+  ThreadArena() noexcept : arena() {
+    lock_guard lock(registryMutex);
+    registry.push_back(&arena);
+  }
+  ThreadArena(ThreadArena const &) noexcept = delete;
+  ThreadArena(ThreadArena &&) noexcept = delete;
+
+  ~ThreadArena() noexcept {
+    lock_guard lock(registryMutex);
+    erase(registry, &arena);
+  }
+
+  ThreadArena &operator=(ThreadArena const &) noexcept = delete;
+  ThreadArena &operator=(ThreadArena &&) noexcept = delete;
+
+  Arena arena;
+};
+}  // namespace
+
+Arena::Scope::Scope(Arena &arena_) noexcept
+    : arena(arena_), start(arena_.mark()) {}
+
+Arena::Scope::~Scope() noexcept { arena.rewind(start); }
+
+Arena::Arena(size_t blockSize_) noexcept
+    : blockSize(blockSize_),
+      blocks(),
+      top{0, 0, 0},
+      used(0),
+      highWater(0),
+      capacity(0) {}
+
+void *Arena::allocate(size_t size, size_t alignment) noexcept {
+  assert((alignment & (alignment - 1)) == 0 &&
+         "alignment must be a power of two");
+  // skip ahead through blocks kept from before, adding one if none fit
+  while (true) {
+    if (top.block < blocks.size()) {
+      Block &block = blocks[top.block];
+      uintptr_t start = reinterpret_cast<uintptr_t>(block.data.get());
+      uintptr_t aligned =
+          (start + top.offset + alignment - 1) & ~(uintptr_t{alignment} - 1);
+      size_t offset = aligned - start;
+      if (offset <= block.size && size <= block.size - offset) {
+        top.offset = offset + size;
+        size_t now = top.base + top.offset;
+        used.store(now, memory_order_relaxed);
+        if (now > highWater.load(memory_order_relaxed))
+          highWater.store(now, memory_order_relaxed);
+        return block.data.get() + offset;
+      }
+      if (top.offset != 0 || top.block + 1 < blocks.size()) {
+        top.base += block.size;
+        ++top.block;
+        top.offset = 0;
+        continue;
+      }
+    }
+    // an oversized allocation gets a block of its own
+    size_t bytes = max(blockSize, size + alignment);
+    blocks.insert(blocks.begin() + static_cast<ptrdiff_t>(top.block),
+                  Block{make_unique_for_overwrite<std::byte[]>(bytes), bytes});
+    capacity.fetch_add(bytes, memory_order_relaxed);
+  }
+}
+
+Arena::Mark Arena::mark() const noexcept { return top; }
+
+void Arena::rewind(Mark const &mark) noexcept {
+  assert((mark.block < top.block ||
+          (mark.block == top.block && mark.offset <= top.offset)) &&
+         "rewinding past a mark that's already been freed");
+  top = mark;
+  used.store(top.base + top.offset, memory_order_relaxed);
+}
+
+void Arena::reset() noexcept { rewind(Mark{0, 0, 0}); }
+
+AllocatorStats Arena::getStats() const noexcept {
+  return AllocatorStats{used.load(memory_order_relaxed),
+                        highWater.load(memory_order_relaxed),
+                        capacity.load(memory_order_relaxed)};
+}
+
+Arena &threadArena() noexcept {
+  thread_local ThreadArena arena;
+  return arena.arena;
+}
+
+AllocatorStats threadArenaStats() noexcept {
+  AllocatorStats total{0, 0, 0};
+  lock_guard lock(registryMutex);
+  for (Arena const *arena : registry) {
+    AllocatorStats stats = arena->getStats();
+    total.used += stats.used;
+    total.highWater += stats.highWater;
+    total.capacity += stats.capacity;
+  }
+  return total;
+}
+}  // namespace carrier_conquest::util
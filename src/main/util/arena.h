@@ -0,0 +1,152 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_UTIL_ARENA_H_
+#define CARRIERCONQUEST_UTIL_ARENA_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace carrier_conquest::util {
+struct AllocatorStats final {
+  size_t used;       // bytes, or objects for a pool
+  size_t highWater;  // most ever used at once
+  size_t capacity;   // reserved, used or not
+};
+
+// a bump allocator - allocations are never freed on their own, only all at
+// once, by rewinding to a mark or resetting
+// memory is kept for reuse, so once an arena has grown to fit its busiest
+// tick or frame it stops touching the heap
+class Arena final {
+ public:
+  struct Mark final {
+    size_t block;
+    size_t offset;
+    size_t base;  // bytes in blocks before this one
+  };
+
+  // rewinds the arena to where it was on construction
+  class Scope final {
+   public:
+    explicit Scope(Arena &arena) noexcept;
+    Scope(Scope const &) noexcept = delete;
+    Scope(Scope &&) noexcept = delete;
+
+    ~Scope() noexcept;
+
+    Scope &operator=(Scope const &) noexcept = delete;
+    Scope &operator=(Scope &&) noexcept = delete;
+
+   private:
+    Arena &arena;
+    Mark start;
+  };
+
+  explicit Arena(size_t blockSize = DEFAULT_BLOCK_SIZE) noexcept;
+  Arena(Arena const &) noexcept = delete;
+  Arena(Arena &&) noexcept = delete;
+
+  ~Arena() noexcept = default;
+
+  Arena &operator=(Arena const &) noexcept = delete;
+  Arena &operator=(Arena &&) noexcept = delete;
+
+  void *allocate(size_t size, size_t alignment) noexcept;
+  // uninitialized, so only for types that needn't be constructed or
+  // destroyed
+  template <typename T>
+  std::span<T> allocate(size_t count) noexcept {
+    static_assert(std::is_trivially_default_constructible_v<T> &&
+                      std::is_trivially_destructible_v<T>,
+                  "arenas neither construct nor destroy");
+    return std::span<T>(
+        static_cast<T *>(allocate(count * sizeof(T), alignof(T))), count);
+  }
+
+  Mark mark() const noexcept;
+  // frees everything allocated since mark was taken
+  void rewind(Mark const &mark) noexcept;
+  void reset() noexcept;
+
+  // safe to call from any thread
+  AllocatorStats getStats() const noexcept;
+
+  static constexpr size_t DEFAULT_BLOCK_SIZE = 1 << 20;  // bytes
+
+ private:
+  struct Block final {
+    std::unique_ptr<std::byte[]> data;
+    size_t size;
+  };
+
+  size_t blockSize;
+  std::vector<Block> blocks;
+  Mark top;
+
+  // written only by the owning thread
+  std::atomic<size_t> used;
+  std::atomic<size_t> highWater;
+  std::atomic<size_t> capacity;
+};
+
+// adapts an arena for standard containers - deallocating does nothing, so
+// a growing container leaves its old buffers behind until the arena rewinds
+// not final, since containers may derive from their allocator
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+
+  explicit ArenaAllocator(Arena &arena_) noexcept : arena(&arena_) {}
+  template <typename U>
+  ArenaAllocator(ArenaAllocator<U> const &other) noexcept
+      : arena(other.getArena()) {}
+
+  T *allocate(size_t count) noexcept {
+    return static_cast<T *>(arena->allocate(count * sizeof(T), alignof(T)));
+  }
+  void deallocate(T *, size_t) noexcept {}
+
+  Arena *getArena() const noexcept { return arena; }
+
+  template <typename U>
+  bool operator==(ArenaAllocator<U> const &other) const noexcept {
+    return arena == other.getArena();
+  }
+
+ private:
+  Arena *arena;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+// this thread's scratch arena, for memory that doesn't outlive a job, tick or
+// frame - take a Scope around each use, so uses may nest
+Arena &threadArena() noexcept;
+// summed over every thread's scratch arena
+AllocatorStats threadArenaStats() noexcept;
+}  // namespace carrier_conquest::util
+
+#endif  // CARRIERCONQUEST_UTIL_ARENA_H_
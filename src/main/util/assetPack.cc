@@ -0,0 +1,122 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "util/assetPack.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "util/exceptions/initException.h"
+
+using namespace std;
+using namespace std::filesystem;
+using namespace carrier_conquest::util::exceptions;
+
+namespace carrier_conquest::util {
+AssetPack::AssetPack(path const &filename)
+    : data(nullptr), size(0), entries() {
+  int fd = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd == -1)
+    throw InitException("Could not open asset pack",
+                        "Could not read file " + filename.string());
+
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    throw InitException("Could not open asset pack",
+                        "Could not read file " + filename.string());
+  }
+  size = static_cast<size_t>(info.st_size);
+
+  void *mapped = size == 0 ? MAP_FAILED
+                           : mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);  // the mapping keeps the file alive
+  if (mapped == MAP_FAILED)
+    throw InitException("Could not open asset pack",
+                        "Could not map file " + filename.string());
+  data = static_cast<std::byte const *>(mapped);
+
+  PackHeader header;
+  if (size < sizeof(PackHeader)) {
+    munmap(mapped, size);
+    throw InitException("Could not open asset pack",
+                        filename.string() + " is truncated");
+  }
+  memcpy(&header, data, sizeof(PackHeader));
+  if (memcmp(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0 ||
+      header.version != PACK_VERSION ||
+      header.count > (size - sizeof(PackHeader)) / sizeof(PackEntry)) {
+    munmap(mapped, size);
+    throw InitException("Could not open asset pack",
+                        filename.string() + " is not a valid asset pack");
+  }
+  entries = span<PackEntry const>(
+      reinterpret_cast<PackEntry const *>(data + sizeof(PackHeader)),
+      header.count);
+
+  for (PackEntry const &entry : entries) {
+    if (entry.nameOffset > size || entry.nameLength > size - entry.nameOffset ||
+        entry.dataOffset > size || entry.dataSize > size - entry.dataOffset) {
+      munmap(mapped, size);
+      throw InitException("Could not open asset pack",
+                          filename.string() + " is corrupted");
+    }
+  }
+}
+
+AssetPack::~AssetPack() noexcept {
+  munmap(const_cast<std::byte *>(data), size);
+}
+
+span<std::byte const> AssetPack::get(path const &name) const {
+  string key = name.generic_string();
+  auto found =
+      lower_bound(entries.begin(), entries.end(), key,
+                  [this](PackEntry const &entry, string const &target) {
+                    return nameOf(entry) < target;
+                  });
+  if (found == entries.end() || nameOf(*found) != key)
+    throw InitException("Failed to load asset " + key,
+                        "Asset pack does not contain " + key);
+
+  return span<std::byte const>(data + found->dataOffset, found->dataSize);
+}
+
+void AssetPack::prefetch(span<std::byte const> asset) const noexcept {
+  if (asset.empty()) return;
+  uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  uintptr_t start = reinterpret_cast<uintptr_t>(asset.data()) / page * page;
+  uintptr_t end = reinterpret_cast<uintptr_t>(asset.data() + asset.size());
+  // advisory only - a failure just means the upload faults the pages in
+  madvise(reinterpret_cast<void *>(start), end - start, MADV_WILLNEED);
+}
+
+string_view AssetPack::nameOf(PackEntry const &entry) const noexcept {
+  return string_view(reinterpret_cast<char const *>(data + entry.nameOffset),
+                     entry.nameLength);
+}
+
+unique_ptr<AssetPack> assets;
+}  // namespace carrier_conquest::util
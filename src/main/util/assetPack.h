@@ -0,0 +1,82 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_UTIL_ASSETPACK_H_
+#define CARRIERCONQUEST_UTIL_ASSETPACK_H_
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string_view>
+
+namespace carrier_conquest::util {
+// on-disk layout - a header, then a name-sorted entry table, then the names,
+// then the data of each asset, each aligned to PACK_ALIGNMENT
+// all fields are little-endian
+struct PackHeader final {
+  char magic[4];
+  uint32_t version;
+  uint64_t count;
+};
+
+struct PackEntry final {
+  uint64_t nameOffset;
+  uint64_t nameLength;
+  uint64_t dataOffset;
+  uint64_t dataSize;
+};
+
+constexpr char PACK_MAGIC[4] = {'C', 'C', 'A', 'P'};
+constexpr uint32_t PACK_VERSION = 1;
+constexpr uint64_t PACK_ALIGNMENT = 16;
+
+static_assert(std::endian::native == std::endian::little,
+              "asset packs are only readable on little-endian hosts");
+
+class AssetPack final {
+ public:
+  explicit AssetPack(std::filesystem::path const &filename);
+  AssetPack(AssetPack const &) noexcept = delete;
+  AssetPack(AssetPack &&) noexcept = delete;
+
+  ~AssetPack() noexcept;
+
+  AssetPack &operator=(AssetPack const &) noexcept = delete;
+  AssetPack &operator=(AssetPack &&) noexcept = delete;
+
+  std::span<std::byte const> get(std::filesystem::path const &name) const;
+
+  // starts reading an asset in from disk without waiting for it
+  void prefetch(std::span<std::byte const> asset) const noexcept;
+
+ private:
+  std::byte const *data;
+  size_t size;
+  std::span<PackEntry const> entries;
+
+  std::string_view nameOf(PackEntry const &entry) const noexcept;
+};
+
+extern std::unique_ptr<AssetPack> assets;
+}  // namespace carrier_conquest::util
+
+#endif  // CARRIERCONQUEST_UTIL_ASSETPACK_H_
@@ -0,0 +1,149 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "util/cookedTexture.h"
+
+#include <array>
+#include <cstring>
+
+using namespace std;
+
+namespace carrier_conquest::util {
+namespace {
+using Texel = array<uint8_t, 4>;
+
+Texel unpack565(uint16_t colour) noexcept {
+  unsigned r = colour >> 11 & 0x1f;
+  unsigned g = colour >> 5 & 0x3f;
+  unsigned b = colour & 0x1f;
+  return {static_cast<uint8_t>(r << 3 | r >> 2),
+          static_cast<uint8_t>(g << 2 | g >> 4),
+          static_cast<uint8_t>(b << 3 | b >> 2), 255};
+}
+
+uint8_t mix(unsigned a, unsigned b, unsigned weightA, unsigned weightB,
+            unsigned total) noexcept {
+  return static_cast<uint8_t>((weightA * a + weightB * b) / total);
+}
+
+// the colour half of a block - BC1 alone has a three-colour mode, picked by
+// the endpoints' order, whose fourth colour is black
+void decodeColour(std::byte const *block, bool alwaysFourColour,
+                  array<Texel, 16> &texels) noexcept {
+  uint16_t c0;
+  uint16_t c1;
+  uint32_t indices;
+  memcpy(&c0, block, sizeof(c0));
+  memcpy(&c1, block + 2, sizeof(c1));
+  memcpy(&indices, block + 4, sizeof(indices));
+
+  array<Texel, 4> palette = {unpack565(c0), unpack565(c1)};
+  bool fourColour = alwaysFourColour || c0 > c1;
+  for (size_t channel = 0; channel < 3; ++channel) {
+    unsigned a = palette[0][channel];
+    unsigned b = palette[1][channel];
+    palette[2][channel] = fourColour ? mix(a, b, 2, 1, 3) : mix(a, b, 1, 1, 2);
+    palette[3][channel] = fourColour ? mix(a, b, 1, 2, 3) : 0;
+  }
+  palette[2][3] = palette[3][3] = 255;
+
+  for (size_t idx = 0; idx < texels.size(); ++idx)
+    texels[idx] = palette[indices >> (2 * idx) & 0x3];
+}
+
+// the alpha half of a BC3 block
+void decodeAlpha(std::byte const *block, array<Texel, 16> &texels) noexcept {
+  unsigned a0 = static_cast<unsigned>(block[0]);
+  unsigned a1 = static_cast<unsigned>(block[1]);
+  uint64_t indices = 0;
+  memcpy(&indices, block + 2, 6);
+
+  array<uint8_t, 8> palette = {static_cast<uint8_t>(a0),
+                               static_cast<uint8_t>(a1)};
+  if (a0 > a1) {
+    for (unsigned step = 1; step < 7; ++step)
+      palette[step + 1] = mix(a0, a1, 7 - step, step, 7);
+  } else {
+    for (unsigned step = 1; step < 5; ++step)
+      palette[step + 1] = mix(a0, a1, 5 - step, step, 5);
+    palette[6] = 0;
+    palette[7] = 255;
+  }
+
+  for (size_t idx = 0; idx < texels.size(); ++idx)
+    texels[idx][3] = palette[indices >> (3 * idx) & 0x7];
+}
+}  // namespace
+
+bool validCookedTexture(span<std::byte const> file) noexcept {
+  CookedTextureHeader header;
+  if (file.size() < sizeof(CookedTextureHeader)) return false;
+  memcpy(&header, file.data(), sizeof(CookedTextureHeader));
+  if (memcmp(header.magic, COOKED_TEXTURE_MAGIC,
+             sizeof(COOKED_TEXTURE_MAGIC)) != 0 ||
+      header.version != COOKED_TEXTURE_VERSION || header.levels == 0 ||
+      header.levels > 32 || header.format > TextureFormat::BC4)
+    return false;
+  if (file.size() < sizeof(CookedTextureHeader) +
+                        header.levels * sizeof(CookedTextureLevel))
+    return false;
+
+  uint32_t width = header.width;
+  uint32_t height = header.height;
+  for (uint32_t level = 0; level < header.levels; ++level) {
+    CookedTextureLevel info;
+    memcpy(&info,
+           file.data() + sizeof(CookedTextureHeader) +
+               level * sizeof(CookedTextureLevel),
+           sizeof(CookedTextureLevel));
+    if (info.width != width || info.height != height ||
+        info.size != levelSize(header.format, width, height) ||
+        info.offset > file.size() || info.size > file.size() - info.offset)
+      return false;
+    width = width > 1 ? width / 2 : 1;
+    height = height > 1 ? height / 2 : 1;
+  }
+
+  return true;
+}
+
+void decodeS3tc(TextureFormat format, uint32_t width, uint32_t height,
+                span<std::byte const> blocks,
+                span<std::byte> pixels) noexcept {
+  size_t blockSize = format == TextureFormat::BC3 ? 16 : 8;
+  std::byte const *block = blocks.data();
+  for (uint32_t y = 0; y < height; y += 4) {
+    for (uint32_t x = 0; x < width; x += 4, block += blockSize) {
+      array<Texel, 16> texels;
+      if (format == TextureFormat::BC3) {
+        decodeColour(block + 8, true, texels);
+        decodeAlpha(block, texels);
+      } else {
+        decodeColour(block, false, texels);
+      }
+
+      // edge blocks hang off the level
+      for (uint32_t row = 0; row < 4 && y + row < height; ++row)
+        for (uint32_t column = 0; column < 4 && x + column < width; ++column)
+          memcpy(&pixels[(size_t{y + row} * width + x + column) * 4],
+                 texels[row * 4 + column].data(), 4);
+    }
+  }
+}
+}  // namespace carrier_conquest::util
@@ -0,0 +1,94 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_UTIL_COOKEDTEXTURE_H_
+#define CARRIERCONQUEST_UTIL_COOKEDTEXTURE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace carrier_conquest::util {
+// on-disk layout of a cooked (.cctex) texture - a header, a table of mip
+// levels (largest first), then the upload-ready data of each level
+// rows are stored bottom to top, as OpenGL expects them
+enum class TextureFormat : uint32_t {
+  RGBA8,
+  R8,
+  BC1,  // S3TC DXT1, opaque RGB
+  BC3,  // S3TC DXT5, RGBA
+  BC4,  // RGTC1, single channel
+};
+
+struct CookedTextureHeader final {
+  char magic[4];
+  uint32_t version;
+  TextureFormat format;
+  uint32_t width;
+  uint32_t height;
+  uint32_t levels;
+};
+
+struct CookedTextureLevel final {
+  uint32_t width;
+  uint32_t height;
+  uint64_t offset;
+  uint64_t size;
+};
+
+constexpr char COOKED_TEXTURE_MAGIC[4] = {'C', 'C', 'T', 'X'};
+constexpr uint32_t COOKED_TEXTURE_VERSION = 1;
+
+constexpr bool isCompressed(TextureFormat format) noexcept {
+  return format == TextureFormat::BC1 || format == TextureFormat::BC3 ||
+         format == TextureFormat::BC4;
+}
+
+constexpr uint64_t levelSize(TextureFormat format, uint32_t width,
+                             uint32_t height) noexcept {
+  uint64_t blocks = ((width + 3ull) / 4) * ((height + 3ull) / 4);
+  switch (format) {
+    case TextureFormat::RGBA8: {
+      return uint64_t{width} * height * 4;
+    }
+    case TextureFormat::R8: {
+      return uint64_t{width} * height;
+    }
+    case TextureFormat::BC1:
+    case TextureFormat::BC4: {
+      return blocks * 8;
+    }
+    case TextureFormat::BC3: {
+      return blocks * 16;
+    }
+  }
+  return 0;
+}
+
+// checks the header and level table of a cooked texture against its size
+bool validCookedTexture(std::span<std::byte const> file) noexcept;
+
+// decodes a level of BC1 or BC3 blocks into width * height RGBA8 pixels, for
+// drivers that can't sample S3TC
+void decodeS3tc(TextureFormat format, uint32_t width, uint32_t height,
+                std::span<std::byte const> blocks,
+                std::span<std::byte> pixels) noexcept;
+}  // namespace carrier_conquest::util
+
+#endif  // CARRIERCONQUEST_UTIL_COOKEDTEXTURE_H_
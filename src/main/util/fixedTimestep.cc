@@ -0,0 +1,43 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "util/fixedTimestep.h"
+
+namespace carrier_conquest::util {
+FixedTimestep::FixedTimestep(double tickLength) noexcept
+    : tickLength(tickLength), accumulator(0.0) {}
+
+unsigned FixedTimestep::advance(double elapsed) noexcept {
+  accumulator += elapsed;
+  unsigned ticks = 0;
+  while (accumulator >= tickLength) {
+    if (ticks == MAX_TICKS) {
+      accumulator = 0.0;
+      break;
+    }
+    accumulator -= tickLength;
+    ++ticks;
+  }
+  return ticks;
+}
+
+double FixedTimestep::getAlpha() const noexcept {
+  return accumulator / tickLength;
+}
+}  // namespace carrier_conquest::util
@@ -0,0 +1,52 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_UTIL_FIXEDTIMESTEP_H_
+#define CARRIERCONQUEST_UTIL_FIXEDTIMESTEP_H_
+
+namespace carrier_conquest::util {
+// turns variable frame times into a whole number of fixed-length ticks,
+// carrying the remainder over to the next frame
+class FixedTimestep final {
+ public:
+  explicit FixedTimestep(double tickLength) noexcept;
+  FixedTimestep(FixedTimestep const &) noexcept = default;
+  FixedTimestep(FixedTimestep &&) noexcept = default;
+
+  ~FixedTimestep() noexcept = default;
+
+  FixedTimestep &operator=(FixedTimestep const &) noexcept = default;
+  FixedTimestep &operator=(FixedTimestep &&) noexcept = default;
+
+  // adds elapsed seconds, returning the number of ticks now due
+  unsigned advance(double elapsed) noexcept;
+  // fraction of a tick accumulated since the last one, in [0, 1)
+  double getAlpha() const noexcept;
+
+  // ticks per advance - past this, the simulation falls behind wall time
+  // rather than spending ever longer catching up
+  static constexpr unsigned MAX_TICKS = 8;
+
+ private:
+  double tickLength;
+  double accumulator;
+};
+}  // namespace carrier_conquest::util
+
+#endif  // CARRIERCONQUEST_UTIL_FIXEDTIMESTEP_H_
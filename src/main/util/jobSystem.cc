@@ -0,0 +1,267 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "util/jobSystem.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace carrier_conquest::util {
+namespace {
+// which worker of which system the current thread is, if any
+thread_local JobSystem const *currentSystem = nullptr;
+thread_local size_t currentWorker = 0;
+}  // namespace
+
+Job::Job(Function function_, bool mainThread_, bool workersOnly_,
+         stop_token const &shutdown) noexcept
+    : function(move(function_)),
+      mainThread(mainThread_),
+      workersOnly(workersOnly_),
+      stopSource(),
+      onShutdown(shutdown, [this]() { stopSource.request_stop(); }),
+      pending(1),
+      done(false),
+      mutex(),
+      continuations() {}
+
+bool Job::isDone() const noexcept { return done; }
+
+void Job::cancel() noexcept { stopSource.request_stop(); }
+
+JobSystem::JobSystem() noexcept
+    : JobSystem(max(thread::hardware_concurrency(), 2u) - 1) {}
+
+JobSystem::JobSystem(size_t workerCount) noexcept
+    : mainThread(this_thread::get_id()),
+      shutdown(),
+      workers(),
+      sharedMutex(),
+      shared(),
+      background(),
+      mainMutex(),
+      mainQueue(),
+      mainWaiting(nullptr),
+      mainSignal(0),
+      queued(0),
+      sleepMutex(),
+      wake(),
+      threads() {
+  for (size_t index = 0; index < workerCount; ++index)
+    workers.push_back(make_unique<Worker>());
+  for (size_t index = 0; index < workerCount; ++index)
+    threads.emplace_back(
+        [this, index](stop_token token) { run(token, index); });
+}
+
+JobSystem::~JobSystem() noexcept {
+  shutdown.request_stop();
+  threads.clear();
+}
+
+JobSystem::Handle JobSystem::submit(Function function,
+                                    initializer_list<Handle> dependencies,
+                                    Affinity affinity) noexcept {
+  Handle job(new Job(move(function), affinity == Affinity::MAIN_THREAD,
+                     affinity == Affinity::WORKERS, shutdown.get_token()));
+  for (Handle const &dependency : dependencies) {
+    if (dependency == nullptr) continue;
+    lock_guard lock(dependency->mutex);
+    if (dependency->done) continue;
+    ++job->pending;
+    dependency->continuations.push_back(job);
+  }
+  if (--job->pending == 0) schedule(job);
+  return job;
+}
+
+JobSystem::Handle JobSystem::then(Handle const &job, Function function,
+                                  Affinity affinity) noexcept {
+  return submit(move(function), {job}, affinity);
+}
+
+void JobSystem::wait(Handle const &job) noexcept {
+  bool onMain = this_thread::get_id() == mainThread;
+  while (!job->done) {
+    if (onMain) runMainThread();
+    // with no workers, waiting threads are the only ones to run jobs at all
+    if (Handle other = find(workers.empty()); other) {
+      execute(other);
+    } else if (workers.empty()) {
+      // nothing else would pick up the job once it's ready
+      this_thread::yield();
+    } else if (onMain) {
+      // sleeps until the job's done or there's main thread work to run -
+      // workers may yet give it some
+      uint32_t signal = mainSignal;
+      mainWaiting = job.get();
+      bool idle;
+      {
+        lock_guard lock(mainMutex);
+        idle = mainQueue.empty();
+      }
+      if (idle && !job->done) mainSignal.wait(signal);
+      mainWaiting = nullptr;
+    } else {
+      // whatever's left is already running, or will be, on some worker
+      job->done.wait(false);
+    }
+  }
+}
+
+void JobSystem::parallelFor(
+    size_t count, size_t grain,
+    function<void(size_t, size_t)> const &function) noexcept {
+  grain = max(grain, size_t{1});
+  size_t chunks = min((count + grain - 1) / grain, workers.size() + 1);
+  if (chunks <= 1) {
+    if (count != 0) function(0, count);
+    return;
+  }
+
+  size_t chunkSize = (count + chunks - 1) / chunks;
+  vector<Handle> parts;
+  for (size_t begin = chunkSize; begin < count; begin += chunkSize) {
+    size_t end = min(begin + chunkSize, count);
+    parts.push_back(submit(
+        [&function, begin, end](stop_token const &) { function(begin, end); }));
+  }
+  // the calling thread takes the first chunk itself
+  function(0, chunkSize);
+  for (Handle const &part : parts) wait(part);
+}
+
+void JobSystem::runMainThread() noexcept {
+  deque<Handle> ready;
+  {
+    lock_guard lock(mainMutex);
+    ready.swap(mainQueue);
+  }
+  for (Handle const &job : ready) execute(job);
+}
+
+size_t JobSystem::getWorkerCount() const noexcept { return workers.size(); }
+
+void JobSystem::schedule(Handle job) noexcept {
+  if (job->mainThread) {
+    {
+      lock_guard lock(mainMutex);
+      mainQueue.push_back(move(job));
+    }
+    ++mainSignal;
+    mainSignal.notify_one();
+    return;
+  }
+
+  if (job->workersOnly) {
+    lock_guard lock(sharedMutex);
+    background.push_back(move(job));
+  } else if (currentSystem == this) {
+    Worker &worker = *workers[currentWorker];
+    lock_guard lock(worker.mutex);
+    worker.queue.push_back(move(job));
+  } else {
+    lock_guard lock(sharedMutex);
+    shared.push_back(move(job));
+  }
+  ++queued;
+  {
+    // a worker checking queued then going to sleep can't miss this
+    lock_guard lock(sleepMutex);
+  }
+  wake.notify_one();
+}
+
+JobSystem::Handle JobSystem::find(bool idle) noexcept {
+  if (queued == 0) return nullptr;
+
+  Handle job;
+  size_t start = 0;
+  if (currentSystem == this) {
+    start = currentWorker + 1;
+    Worker &own = *workers[currentWorker];
+    lock_guard lock(own.mutex);
+    if (!own.queue.empty()) {
+      job = move(own.queue.back());
+      own.queue.pop_back();
+    }
+  }
+  if (!job) {
+    lock_guard lock(sharedMutex);
+    if (!shared.empty()) {
+      job = move(shared.front());
+      shared.pop_front();
+    }
+  }
+  for (size_t offset = 0; !job && offset < workers.size(); ++offset) {
+    Worker &victim = *workers[(start + offset) % workers.size()];
+    lock_guard lock(victim.mutex);
+    if (!victim.queue.empty()) {
+      job = move(victim.queue.front());
+      victim.queue.pop_front();
+    }
+  }
+  if (!job && idle) {
+    lock_guard lock(sharedMutex);
+    if (!background.empty()) {
+      job = move(background.front());
+      background.pop_front();
+    }
+  }
+
+  if (job) --queued;
+  return job;
+}
+
+void JobSystem::execute(Handle const &job) noexcept {
+  stop_token token = job->stopSource.get_token();
+  if (!token.stop_requested()) job->function(token);
+  job->function = nullptr;
+
+  vector<Handle> continuations;
+  {
+    lock_guard lock(job->mutex);
+    job->done = true;
+    continuations.swap(job->continuations);
+  }
+  job->done.notify_all();
+  if (mainWaiting == job.get()) {
+    ++mainSignal;
+    mainSignal.notify_one();
+  }
+  for (Handle &continuation : continuations)
+    if (--continuation->pending == 0) schedule(move(continuation));
+}
+
+void JobSystem::run(stop_token const &token, size_t index) noexcept {
+  currentSystem = this;
+  currentWorker = index;
+  while (!token.stop_requested()) {
+    if (Handle job = find(true); job) {
+      execute(job);
+    } else {
+      unique_lock lock(sleepMutex);
+      wake.wait(lock, token, [this]() { return queued != 0; });
+    }
+  }
+}
+
+unique_ptr<JobSystem> jobs;
+}  // namespace carrier_conquest::util
@@ -0,0 +1,166 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_UTIL_JOBSYSTEM_H_
+#define CARRIERCONQUEST_UTIL_JOBSYSTEM_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace carrier_conquest::util {
+// a unit of work for the job system - runs once all of its dependencies have
+// finished, on any worker or, if asked for, on the main thread
+class Job final {
+ public:
+  Job(Job const &) noexcept = delete;
+  Job(Job &&) noexcept = delete;
+
+  ~Job() noexcept = default;
+
+  Job &operator=(Job const &) noexcept = delete;
+  Job &operator=(Job &&) noexcept = delete;
+
+  // true once the job has run, or been skipped after being cancelled
+  bool isDone() const noexcept;
+  // requests that the job stop; if it hasn't started yet, it never will
+  void cancel() noexcept;
+
+ private:
+  friend class JobSystem;
+
+  using Function = std::function<void(std::stop_token const &)>;
+
+  Job(Function function, bool mainThread, bool workersOnly,
+      std::stop_token const &shutdown) noexcept;
+
+  Function function;
+  bool mainThread;
+  bool workersOnly;
+  std::stop_source stopSource;
+  std::stop_callback<std::function<void()>> onShutdown;
+  // unfinished dependencies, plus one while the job is being submitted
+  std::atomic<uint32_t> pending;
+  std::atomic_bool done;
+
+  std::mutex mutex;  // guards continuations, and done against them
+  std::vector<std::shared_ptr<Job>> continuations;
+};
+
+// work-stealing scheduler - one worker per core, less one for the main
+// thread, each with its own deque
+// a worker pushes and pops jobs at the back of its deque; idle workers steal
+// from the front of others', and jobs submitted from other threads start out
+// in a shared queue
+class JobSystem final {
+ public:
+  using Handle = std::shared_ptr<Job>;
+  using Function = Job::Function;
+
+  enum class Affinity {
+    ANY,
+    MAIN_THREAD,  // run by runMainThread
+    // run only by idle workers, never by a thread waiting on another job -
+    // for work that mustn't stall whoever submitted it; don't wait for one
+    // from within a job, unless there are no workers
+    WORKERS,
+  };
+
+  // must be constructed on the main thread
+  JobSystem() noexcept;
+  // with no workers, jobs run only on threads waiting for them, and
+  // parallelFor runs inline
+  explicit JobSystem(size_t workerCount) noexcept;
+  JobSystem(JobSystem const &) noexcept = delete;
+  JobSystem(JobSystem &&) noexcept = delete;
+
+  // cancels all outstanding jobs and joins the workers
+  ~JobSystem() noexcept;
+
+  JobSystem &operator=(JobSystem const &) noexcept = delete;
+  JobSystem &operator=(JobSystem &&) noexcept = delete;
+
+  // runs function once its dependencies are done - null ones are ignored
+  Handle submit(Function function,
+                std::initializer_list<Handle> dependencies = {},
+                Affinity affinity = Affinity::ANY) noexcept;
+  // runs function once job is done
+  Handle then(Handle const &job, Function function,
+              Affinity affinity = Affinity::ANY) noexcept;
+
+  // runs other jobs until this one is done
+  void wait(Handle const &job) noexcept;
+
+  // splits [0, count) into chunks of at least grain items, runs them in
+  // parallel, and returns once they're all done
+  void parallelFor(
+      size_t count, size_t grain,
+      std::function<void(size_t begin, size_t end)> const &function) noexcept;
+
+  // runs jobs with main thread affinity - call once a frame
+  void runMainThread() noexcept;
+
+  size_t getWorkerCount() const noexcept;
+
+ private:
+  struct Worker final {
+    std::mutex mutex;
+    std::deque<Handle> queue;
+  };
+
+  std::thread::id mainThread;
+  std::stop_source shutdown;
+
+  std::vector<std::unique_ptr<Worker>> workers;
+  std::mutex sharedMutex;
+  std::deque<Handle> shared;
+  std::deque<Handle> background;  // WORKERS jobs, also under sharedMutex
+  std::mutex mainMutex;
+  std::deque<Handle> mainQueue;
+  // the job the main thread is sleeping on, if it is - mainSignal changes
+  // when that job's done, or when there's a job for the main thread to run
+  std::atomic<Job const *> mainWaiting;
+  std::atomic<uint32_t> mainSignal;
+
+  // jobs in workers' and the shared and background queues
+  std::atomic<size_t> queued;
+  std::mutex sleepMutex;
+  std::condition_variable_any wake;
+
+  std::vector<std::jthread> threads;
+
+  void schedule(Handle job) noexcept;
+  // WORKERS jobs are only taken if idle
+  Handle find(bool idle) noexcept;
+  void execute(Handle const &job) noexcept;
+  void run(std::stop_token const &token, size_t index) noexcept;
+};
+
+extern std::unique_ptr<JobSystem> jobs;
+}  // namespace carrier_conquest::util
+
+#endif  // CARRIERCONQUEST_UTIL_JOBSYSTEM_H_
@@ -19,7 +19,15 @@
 
 #include "util/paths.h"
 
+#include <pwd.h>
+#include <unistd.h>
+
+#include <cstdlib>
+
+#include "util/exceptions/initException.h"
+
 using namespace std::filesystem;
+using namespace carrier_conquest::util::exceptions;
 
 namespace carrier_conquest::util {
 #if !defined(NDEBUG)
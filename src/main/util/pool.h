@@ -0,0 +1,157 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_UTIL_POOL_H_
+#define CARRIERCONQUEST_UTIL_POOL_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "util/arena.h"
+
+namespace carrier_conquest::util {
+// fixed-size slots for objects of one type, handed out and taken back one at
+// a time - slots are allocated a chunk at a time and never move or shrink,
+// so a pool stops touching the heap once it's grown to fit its busiest time
+// handles carry a generation, so a handle to a destroyed object - even one
+// whose slot has since been reused - is recognizably stale
+// not thread-safe - use from one thread at a time
+template <typename T>
+class Pool final {
+ public:
+  struct Handle final {
+    uint32_t index;
+    uint32_t generation;
+
+    bool operator==(Handle const &) const noexcept = default;
+  };
+
+  static constexpr Handle NONE = {UINT32_MAX, UINT32_MAX};
+
+  explicit Pool(size_t chunkSize_ = DEFAULT_CHUNK_SIZE) noexcept
+      : chunkSize(chunkSize_),
+        chunks(),
+        freeHead(UINT32_MAX),
+        slotCount(0),
+        live(0),
+        highWater(0) {}
+  Pool(Pool const &) noexcept = delete;
+  Pool(Pool &&) noexcept = delete;
+
+  ~Pool() noexcept {
+    for (uint32_t index = 0; index < slotCount; ++index)
+      if (slot(index).live) object(index)->~T();
+  }
+
+  Pool &operator=(Pool const &) noexcept = delete;
+  Pool &operator=(Pool &&) noexcept = delete;
+
+  template <typename... Args>
+  Handle create(Args &&...args) {
+    if (freeHead == UINT32_MAX) grow();
+    uint32_t index = freeHead;
+    Slot &s = slot(index);
+    new (s.storage) T(std::forward<Args>(args)...);
+    freeHead = s.nextFree;
+    s.live = true;
+    ++live;
+    if (live > highWater) highWater = live;
+    return Handle{index, s.generation};
+  }
+
+  void destroy(Handle handle) noexcept {
+    assert(alive(handle) && "object has already been destroyed");
+    Slot &s = slot(handle.index);
+    object(handle.index)->~T();
+    s.live = false;
+    ++s.generation;
+    s.nextFree = freeHead;
+    freeHead = handle.index;
+    --live;
+  }
+
+  bool alive(Handle handle) const noexcept {
+    return handle.index < slotCount && slot(handle.index).live &&
+           slot(handle.index).generation == handle.generation;
+  }
+
+  // null if the handle is stale
+  T *get(Handle handle) noexcept {
+    return alive(handle) ? object(handle.index) : nullptr;
+  }
+  T const *get(Handle handle) const noexcept {
+    return alive(handle) ? object(handle.index) : nullptr;
+  }
+
+  size_t size() const noexcept { return live; }
+  AllocatorStats getStats() const noexcept {
+    return AllocatorStats{live, highWater, slotCount};
+  }
+
+  static constexpr size_t DEFAULT_CHUNK_SIZE = 1024;  // objects
+
+ private:
+  struct Slot final {
+    alignas(T) std::byte storage[sizeof(T)];
+    uint32_t generation;
+    uint32_t nextFree;  // while free
+    bool live;
+  };
+
+  size_t chunkSize;
+  std::vector<std::unique_ptr<Slot[]>> chunks;
+  uint32_t freeHead;  // UINT32_MAX if none are free
+  uint32_t slotCount;
+  size_t live;
+  size_t highWater;
+
+  Slot &slot(uint32_t index) noexcept {
+    return chunks[index / chunkSize][index % chunkSize];
+  }
+  Slot const &slot(uint32_t index) const noexcept {
+    return chunks[index / chunkSize][index % chunkSize];
+  }
+  T *object(uint32_t index) noexcept {
+    return std::launder(reinterpret_cast<T *>(slot(index).storage));
+  }
+  T const *object(uint32_t index) const noexcept {
+    return std::launder(reinterpret_cast<T const *>(slot(index).storage));
+  }
+
+  // adds a chunk of free slots, lowest index first
+  void grow() {
+    chunks.push_back(std::make_unique<Slot[]>(chunkSize));
+    for (size_t offset = chunkSize; offset-- > 0;) {
+      Slot &s = chunks.back()[offset];
+      s.generation = 0;
+      s.live = false;
+      s.nextFree = freeHead;
+      freeHead = static_cast<uint32_t>(slotCount + offset);
+    }
+    slotCount += static_cast<uint32_t>(chunkSize);
+  }
+};
+}  // namespace carrier_conquest::util
+
+#endif  // CARRIERCONQUEST_UTIL_POOL_H_
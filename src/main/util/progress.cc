@@ -17,17 +17,25 @@
 //
 // SPDX-License-Identifier: GPL-3.0-or-later
 
-#include "util/loadingThread.h"
+#include "util/progress.h"
+
+#include <algorithm>
 
 using namespace std;
 
 namespace carrier_conquest::util {
-LoadingThread::LoadingThread(
-    std::function<void(stop_token const &)> const &function_) noexcept
-    : running(true), function(function_), thread([this](stop_token stop) {
-        function(stop);
-        running = false;
-      }) {}
+Progress::Progress() noexcept : done(0), total(0) {}
+
+void Progress::reset(uint32_t total_) noexcept {
+  done = 0;
+  total = total_;
+}
+
+void Progress::advance(uint32_t units) noexcept { done += units; }
 
-bool LoadingThread::isRunning() const noexcept { return running; }
+float Progress::get() const noexcept {
+  uint32_t of = total;
+  if (of == 0) return 0.0f;
+  return min(static_cast<float>(done) / static_cast<float>(of), 1.0f);
+}
 }  // namespace carrier_conquest::util
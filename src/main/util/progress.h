@@ -17,34 +17,36 @@
 //
 // SPDX-License-Identifier: GPL-3.0-or-later
 
-#ifndef CARRIERCONQUEST_UTIL_LOADINGTHREAD_H_
-#define CARRIERCONQUEST_UTIL_LOADINGTHREAD_H_
+#ifndef CARRIERCONQUEST_UTIL_PROGRESS_H_
+#define CARRIERCONQUEST_UTIL_PROGRESS_H_
 
 #include <atomic>
-#include <functional>
-#include <mutex>
-#include <thread>
+#include <cstdint>
 
 namespace carrier_conquest::util {
-class LoadingThread final {
+// how far through a long task is, in units of work - written from any
+// number of threads doing the task, read by whatever's showing it
+class Progress final {
  public:
-  explicit LoadingThread(
-      std::function<void(std::stop_token const &)> const &function) noexcept;
-  LoadingThread(LoadingThread const &) noexcept = delete;
-  LoadingThread(LoadingThread &&) noexcept = default;
+  Progress() noexcept;
+  Progress(Progress const &) noexcept = delete;
+  Progress(Progress &&) noexcept = delete;
 
-  ~LoadingThread() noexcept = default;
+  ~Progress() noexcept = default;
 
-  LoadingThread &operator=(LoadingThread const &) noexcept = delete;
-  LoadingThread &operator=(LoadingThread &&) noexcept = default;
+  Progress &operator=(Progress const &) noexcept = delete;
+  Progress &operator=(Progress &&) noexcept = delete;
 
-  bool isRunning() const noexcept;
+  // starts over, with total units of work to do
+  void reset(uint32_t total) noexcept;
+  void advance(uint32_t units = 1) noexcept;
+  // fraction done, in [0, 1]
+  float get() const noexcept;
 
  private:
-  std::atomic_bool running;
-  std::function<void(std::stop_token const &)> function;
-  std::jthread thread;
+  std::atomic<uint32_t> done;
+  std::atomic<uint32_t> total;
 };
 }  // namespace carrier_conquest::util
 
-#endif  // CARRIERCONQUEST_UTIL_LOADINGTHREAD_H_
+#endif  // CARRIERCONQUEST_UTIL_PROGRESS_H_
@@ -0,0 +1,67 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "util/random.h"
+
+#include <bit>
+
+using namespace std;
+
+namespace carrier_conquest::util {
+namespace {
+uint64_t splitMix(uint64_t &state) noexcept {
+  uint64_t z = (state += 0x9E3779B97F4A7C15u);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+  return z ^ (z >> 31);
+}
+}  // namespace
+
+Random::Random(uint64_t seed) noexcept : state() {
+  for (uint64_t &word : state) word = splitMix(seed);
+}
+
+uint64_t Random::next() noexcept {
+  uint64_t result = rotl(state[1] * 5, 7) * 9;
+  uint64_t t = state[1] << 17;
+  state[2] ^= state[0];
+  state[3] ^= state[1];
+  state[1] ^= state[2];
+  state[0] ^= state[3];
+  state[2] ^= t;
+  state[3] = rotl(state[3], 45);
+  return result;
+}
+
+uint32_t Random::below(uint32_t bound) noexcept {
+  // multiply-shift - the bias is negligible for the bounds used here
+  return static_cast<uint32_t>(((next() >> 32) * bound) >> 32);
+}
+
+float Random::uniform(float min, float max) noexcept {
+  // top 24 bits, exactly representable as a float
+  float unit = static_cast<float>(next() >> 40) * 0x1p-24f;
+  return min + (max - min) * unit;
+}
+
+uint64_t Random::derive(uint64_t seed, uint64_t stream) noexcept {
+  uint64_t state = seed ^ (stream * 0xD1B54A32D192ED03u);
+  return splitMix(state);
+}
+}  // namespace carrier_conquest::util
@@ -0,0 +1,54 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_UTIL_RANDOM_H_
+#define CARRIERCONQUEST_UTIL_RANDOM_H_
+
+#include <cstdint>
+
+namespace carrier_conquest::util {
+// xoshiro256** - the same seed gives the same sequence on every platform,
+// unlike the standard library's distributions
+class Random final {
+ public:
+  explicit Random(uint64_t seed) noexcept;
+  Random(Random const &) noexcept = default;
+  Random(Random &&) noexcept = default;
+
+  ~Random() noexcept = default;
+
+  Random &operator=(Random const &) noexcept = default;
+  Random &operator=(Random &&) noexcept = default;
+
+  uint64_t next() noexcept;
+  // in [0, bound), bound > 0
+  uint32_t below(uint32_t bound) noexcept;
+  // in [min, max)
+  float uniform(float min, float max) noexcept;
+
+  // combines a seed with a stream number, for independent sequences that
+  // don't depend on which thread draws from which
+  static uint64_t derive(uint64_t seed, uint64_t stream) noexcept;
+
+ private:
+  uint64_t state[4];
+};
+}  // namespace carrier_conquest::util
+
+#endif  // CARRIERCONQUEST_UTIL_RANDOM_H_
@@ -0,0 +1,68 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_UTIL_TRIPLEBUFFER_H_
+#define CARRIERCONQUEST_UTIL_TRIPLEBUFFER_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace carrier_conquest::util {
+// lock-free hand-off of the latest value from one producer thread to one
+// consumer thread - the producer fills the back slot and publishes it, the
+// consumer picks up the newest published slot, and neither ever waits
+template <typename T>
+class TripleBuffer final {
+ public:
+  TripleBuffer() noexcept : slots(), middle(1), back(2), front(0) {}
+  TripleBuffer(TripleBuffer const &) noexcept = delete;
+  TripleBuffer(TripleBuffer &&) noexcept = delete;
+
+  ~TripleBuffer() noexcept = default;
+
+  TripleBuffer &operator=(TripleBuffer const &) noexcept = delete;
+  TripleBuffer &operator=(TripleBuffer &&) noexcept = delete;
+
+  // producer only
+  T &getBack() noexcept { return slots[back]; }
+  void publish() noexcept {
+    back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX;
+  }
+
+  // consumer only - returns true if a newer value was picked up
+  bool update() noexcept {
+    if ((middle.load(std::memory_order_relaxed) & FRESH) == 0) return false;
+    front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+    return true;
+  }
+  T const &getFront() const noexcept { return slots[front]; }
+
+ private:
+  std::array<T, 3> slots;
+  std::atomic<uint8_t> middle;  // index of the slot in between, plus FRESH
+  uint8_t back;
+  uint8_t front;
+
+  static constexpr uint8_t INDEX = 0x3;
+  static constexpr uint8_t FRESH = 0x4;
+};
+}  // namespace carrier_conquest::util
+
+#endif  // CARRIERCONQUEST_UTIL_TRIPLEBUFFER_H_
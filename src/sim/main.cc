@@ -0,0 +1,284 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Runs seeded campaigns headless, as fast as they'll go, one per core, and
+// writes each one's outcome and timing as a row of CSV. Only game/ and util/
+// are linked in, so it needs neither a display nor a GPU
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "game/game.h"
+#include "game/generation.h"
+#include "game/replay.h"
+#include "game/spatialIndex.h"
+#include "game/world.h"
+#include "util/arena.h"
+#include "util/exceptions/loadException.h"
+#include "util/jobSystem.h"
+#include "util/progress.h"
+#include "util/random.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace std::filesystem;
+using namespace carrier_conquest::game;
+using namespace carrier_conquest::util;
+
+namespace {
+struct Settings final {
+  uint64_t runs = 1;
+  uint64_t seed = 0;
+  uint32_t difficulty = 100;
+  double minutes = 10.0;  // of game time per run
+  unsigned threads = max(thread::hardware_concurrency(), 1u);
+  path output;  // standard output if empty
+  path replay;  // re-simulated instead, if given
+};
+
+struct Outcome final {
+  uint64_t seed;
+  uint64_t ticks;
+  double generateSeconds;
+  double simulateSeconds;
+  uint32_t ships[2];  // surviving, by side
+  double hull[2];     // remaining integrity, by side
+  uint32_t projectiles;
+
+  char const *winner() const noexcept {
+    if (ships[static_cast<size_t>(Side::ENEMY)] == 0) return "player";
+    if (ships[static_cast<size_t>(Side::PLAYER)] == 0) return "enemy";
+    return "undecided";
+  }
+};
+
+void usage(char const *name) {
+  cerr << "usage: " << name
+       << " [--runs N] [--seed S] [--difficulty D] [--minutes M]"
+          " [--threads T] [--output FILE]\n"
+       << "       " << name << " --replay FILE [--output FILE]" << endl;
+}
+
+// throws invalid_argument or out_of_range on a bad command line
+Settings parse(int argc, char **argv) {
+  Settings settings;
+  for (int arg = 1; arg < argc; ++arg) {
+    string option = argv[arg];
+    // only asked for once the option's known to take one
+    auto value = [&]() -> string {
+      if (arg + 1 == argc) throw invalid_argument(option + " needs a value");
+      return argv[++arg];
+    };
+    if (option == "--runs") {
+      settings.runs = stoull(value());
+    } else if (option == "--seed") {
+      settings.seed = stoull(value(), nullptr, 0);
+    } else if (option == "--difficulty") {
+      settings.difficulty = static_cast<uint32_t>(stoul(value()));
+    } else if (option == "--minutes") {
+      settings.minutes = stod(value());
+      if (!(settings.minutes > 0.0) || !isfinite(settings.minutes))
+        throw invalid_argument("--minutes must be positive");
+    } else if (option == "--threads") {
+      settings.threads = max(static_cast<unsigned>(stoul(value())), 1u);
+    } else if (option == "--output") {
+      settings.output = value();
+    } else if (option == "--replay") {
+      settings.replay = value();
+    } else {
+      throw invalid_argument("unknown option " + option);
+    }
+  }
+  return settings;
+}
+
+double since(steady_clock::time_point start) noexcept {
+  return duration<double>(steady_clock::now() - start).count();
+}
+
+Outcome run(uint64_t seed, uint32_t difficulty, uint64_t ticks) noexcept {
+  Outcome outcome{};
+  outcome.seed = seed;
+  outcome.ticks = ticks;
+
+  World world;
+  SpatialIndex spatialIndex;
+  Progress progress;
+  steady_clock::time_point start = steady_clock::now();
+  generateCampaign(world, seed, difficulty, stop_token(), progress);
+  spatialIndex.rebuild(world);
+  outcome.generateSeconds = since(start);
+
+  start = steady_clock::now();
+  for (uint64_t tick = 0; tick < ticks; ++tick) step(world, spatialIndex);
+  outcome.simulateSeconds = since(start);
+
+  world.each<Ship, Allegiance, Hull>(
+      [&](Entity, Ship const &, Allegiance const &allegiance,
+          Hull const &hull) {
+        size_t side = static_cast<size_t>(allegiance.side);
+        ++outcome.ships[side];
+        outcome.hull[side] += hull.integrity;
+      });
+  outcome.projectiles =
+      static_cast<uint32_t>(world.store<Projectile>().size());
+  return outcome;
+}
+
+// re-simulates a replay a tick at a time, timing each, so a spike seen in a
+// game can be found and reproduced
+int replay(Settings const &settings) noexcept {
+  try {
+    Replay replay(settings.replay);
+    replay.seek(replay.getStartTick());
+    vector<pair<double, uint64_t>> times;
+    for (uint64_t tick = replay.getStartTick() + 1;
+         tick <= replay.getEndTick(); ++tick) {
+      steady_clock::time_point start = steady_clock::now();
+      replay.seek(tick);
+      times.emplace_back(since(start), tick);
+    }
+
+    ofstream fout;
+    if (!settings.output.empty()) fout.open(settings.output);
+    ostream &out = settings.output.empty() ? cout : fout;
+    out << "tick,step_ms\n";
+    for (auto [seconds, tick] : times)
+      out << tick << "," << seconds * 1e3 << "\n";
+    if (!out) {
+      cerr << "ERROR: Could not write " << settings.output << endl;
+      return EXIT_FAILURE;
+    }
+
+    size_t slowest = min(times.size(), size_t{5});
+    partial_sort(times.begin(), times.begin() + static_cast<ptrdiff_t>(slowest),
+                 times.end(), greater<>());
+    cerr << times.size() << " ticks from " << replay.getStartTick()
+         << ", with " << replay.getCommands().size()
+         << " commands - slowest:";
+    for (size_t index = 0; index < slowest; ++index)
+      cerr << " " << times[index].second << " (" << times[index].first * 1e3
+           << " ms)";
+    cerr << endl;
+    return EXIT_SUCCESS;
+  } catch (exceptions::LoadException const &e) {
+    cerr << "ERROR: " << e.getTitle() << ": " << e.getMessage() << endl;
+    return EXIT_FAILURE;
+  }
+}
+
+void write(ostream &out, uint32_t difficulty,
+           vector<Outcome> const &outcomes) {
+  out << "run,seed,difficulty,ticks,generate_s,simulate_s,ticks_per_s,"
+         "player_ships,enemy_ships,player_hull,enemy_hull,projectiles,winner\n";
+  for (size_t index = 0; index < outcomes.size(); ++index) {
+    Outcome const &outcome = outcomes[index];
+    out << index << "," << outcome.seed << "," << difficulty << ","
+        << outcome.ticks << "," << outcome.generateSeconds << ","
+        << outcome.simulateSeconds << ","
+        << static_cast<double>(outcome.ticks) /
+               max(outcome.simulateSeconds, 1e-9)
+        << "," << outcome.ships[0] << "," << outcome.ships[1] << ","
+        << outcome.hull[0] << "," << outcome.hull[1] << ","
+        << outcome.projectiles << "," << outcome.winner() << "\n";
+  }
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  Settings settings;
+  try {
+    settings = parse(argc, argv);
+  } catch (logic_error const &e) {
+    cerr << "ERROR: " << e.what() << endl;
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  // each run is single-threaded - running one per core is faster than
+  // spreading each over every core
+  jobs = make_unique<JobSystem>(0);
+  if (!settings.replay.empty()) {
+    int status = replay(settings);
+    jobs.reset();
+    return status;
+  }
+
+  double tickLength = static_cast<double>(GameState::TICK_LENGTH);
+  uint64_t ticks =
+      static_cast<uint64_t>(llround(settings.minutes * 60.0 / tickLength));
+  vector<Outcome> outcomes(settings.runs);
+  atomic<uint64_t> next = 0;
+  atomic<size_t> scratch = 0;  // most any thread's arena needed
+  steady_clock::time_point start = steady_clock::now();
+  {
+    vector<jthread> threads;
+    for (unsigned worker = 0; worker < settings.threads; ++worker) {
+      threads.emplace_back([&]() {
+        for (uint64_t index = next++; index < settings.runs; index = next++)
+          outcomes[index] = run(Random::derive(settings.seed, index),
+                                settings.difficulty, ticks);
+        size_t used = threadArena().getStats().highWater;
+        for (size_t seen = scratch; seen < used &&
+                                    !scratch.compare_exchange_weak(seen, used);)
+          continue;
+      });
+    }
+  }
+  double wall = since(start);
+
+  if (settings.output.empty()) {
+    write(cout, settings.difficulty, outcomes);
+  } else {
+    ofstream fout(settings.output);
+    write(fout, settings.difficulty, outcomes);
+    if (!fout) {
+      cerr << "ERROR: Could not write " << settings.output << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  uint64_t players = 0;
+  uint64_t enemies = 0;
+  for (Outcome const &outcome : outcomes) {
+    players += strcmp(outcome.winner(), "player") == 0;
+    enemies += strcmp(outcome.winner(), "enemy") == 0;
+  }
+  cerr << settings.runs << " runs of " << ticks << " ticks in " << wall
+       << " s (" << static_cast<double>(settings.runs * ticks) / wall
+       << " ticks/s) - player won " << players << ", enemy won " << enemies
+       << ", scratch arena peak " << scratch / 1024 << " KiB" << endl;
+
+  jobs.reset();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,118 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "game/replay.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <vector>
+
+#include "game/command.h"
+#include "game/components.h"
+#include "game/game.h"
+#include "game/spatialIndex.h"
+#include "game/testWorlds.h"
+
+using namespace std;
+using namespace std::filesystem;
+using namespace carrier_conquest::game;
+using namespace carrier_conquest::test;
+
+namespace {
+// sets every ship moving, and fires projectiles - guided or not - at some
+void setInMotion(World &world, vector<Entity> const &ships) {
+  for (size_t index = 0; index < ships.size(); ++index) {
+    Velocity &velocity = *world.get<Velocity>(ships[index]);
+    velocity.x = static_cast<float>(index % 7) * 50.0f - 150.0f;
+    velocity.y = static_cast<float>(index % 5) * 50.0f - 100.0f;
+    if (index % 4 != 0) continue;
+
+    Entity target = ships[(index + 1) % ships.size()];
+    Position const &at = *world.get<Position>(target);
+    Entity projectile = world.create();
+    world.add(projectile, Position{at.x + 5'000.0f, at.y});
+    world.add(projectile, Velocity{-1'000.0f, 0.0f});
+    world.add(projectile,
+              Projectile{target, 10.0f, 30.0f, index % 8 == 0 ? 0.0f : 1.0f});
+  }
+}
+}  // namespace
+
+TEST_CASE("seeking a replay gives the same world as playing straight through",
+          "[replay]") {
+  constexpr uint64_t TICKS = 4 * ReplayRecorder::KEYFRAME_INTERVAL + 50;
+  constexpr uint64_t COMMAND_INTERVAL = 70;  // ticks
+  path filename = temp_directory_path() / "carrier-conquest-test.ccreplay";
+
+  // plays the game through, noting the world after every tick
+  World world = generatedWorld(42);
+  SpatialIndex spatialIndex;
+  spatialIndex.rebuild(world);
+  vector<Entity> ships;
+  world.each<Ship>(
+      [&](Entity entity, Ship const &) { ships.push_back(entity); });
+  REQUIRE(!ships.empty());
+  setInMotion(world, ships);
+  size_t projectiles = world.store<Projectile>().size();
+
+  // backwards, forwards, onto and either side of keyframes, and the ends
+  vector<uint64_t> const seeks = {600, 0, 199, 200, 201, 777, TICKS, 1};
+  map<uint64_t, vector<vector<std::byte>>> states;
+  {
+    ReplayRecorder recorder;
+    recorder.keyframe(world, SaveInfo{"Replay", 0, 42, 100});
+    for (uint64_t tick = 0;; ++tick) {
+      if (tick % COMMAND_INTERVAL == 0) {
+        Command command{tick, ships[tick / COMMAND_INTERVAL % ships.size()],
+                        0.0f, 0.0f, CommandType::SELECT, 0};
+        carrier_conquest::game::apply(world, command);
+        recorder.record(command);
+      }
+      if (find(seeks.begin(), seeks.end(), tick) != seeks.end())
+        states[tick] = savedState(world);
+      if (tick == TICKS) break;
+      step(world, spatialIndex);
+      if ((tick + 1) % ReplayRecorder::KEYFRAME_INTERVAL == 0)
+        recorder.keyframe(world, SaveInfo{"Replay", tick + 1, 42, 100});
+    }
+    recorder.save(filename, TICKS);
+  }
+
+  // or there'd be nothing to tell seeks apart
+  REQUIRE(states[0] != states[TICKS]);
+  REQUIRE(world.store<Projectile>().size() < projectiles);
+
+  Replay replay(filename);
+  CHECK(replay.getStartTick() == 0);
+  CHECK(replay.getEndTick() == TICKS);
+  CHECK(replay.getCommands().size() == TICKS / COMMAND_INTERVAL + 1);
+  for (uint64_t tick : seeks) {
+    CAPTURE(tick);
+    replay.seek(tick);
+    CHECK(replay.getTicks() == tick);
+    CHECK(savedState(replay.world) == states[tick]);
+  }
+
+  remove(filename);
+}
@@ -0,0 +1,106 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "game/saveFile.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include "game/testWorlds.h"
+#include "util/exceptions/loadException.h"
+
+using namespace std;
+using namespace carrier_conquest::game;
+using namespace carrier_conquest::test;
+using namespace carrier_conquest::util::exceptions;
+
+namespace {
+vector<std::byte> encoded(World const &world, SaveInfo const &info) {
+  SaveImage image;
+  captureSave(world, info, image);
+  vector<std::byte> bytes;
+  encodeSave(image, bytes);
+  return bytes;
+}
+
+SaveSection section(vector<std::byte> const &bytes, size_t index) {
+  SaveSection section;
+  memcpy(&section,
+         bytes.data() + sizeof(SaveHeader) + index * sizeof(SaveSection),
+         sizeof(SaveSection));
+  return section;
+}
+}  // namespace
+
+TEST_CASE("saves read back exactly as they were captured", "[saveFile]") {
+  World world = generatedWorld(42);
+  vector<std::byte> bytes =
+      encoded(world, SaveInfo{"Round trip", 1234, 42, 100});
+
+  SaveFile save(bytes, "round trip");
+  SaveInfo info = save.getInfo();
+  CHECK(info.name == "Round trip");
+  CHECK(info.ticks == 1234);
+  CHECK(info.seed == 42);
+  CHECK(info.difficulty == 100);
+
+  World read;
+  save.read(read);
+  CHECK(read.size() == world.size());
+  CHECK(savedState(read) == savedState(world));
+}
+
+TEST_CASE("saves that don't match their checksums are rejected",
+          "[saveFile]") {
+  World world = generatedWorld(7);
+  vector<std::byte> bytes = encoded(world, SaveInfo{"Corrupt", 0, 7, 100});
+  REQUIRE_NOTHROW(SaveFile(bytes, "intact"));
+
+  SECTION("in the header") {
+    bytes[offsetof(SaveHeader, summary)] ^= std::byte{0x1};
+    CHECK_THROWS_AS(SaveFile(bytes, "corrupt"), LoadException);
+  }
+  SECTION("in a section") {
+    SaveSection first = section(bytes, 0);
+    REQUIRE(first.storedSize != 0);
+    bytes[first.offset + first.storedSize / 2] ^= std::byte{0x1};
+    CHECK_THROWS_AS(SaveFile(bytes, "corrupt"), LoadException);
+  }
+}
+
+TEST_CASE("truncated saves are rejected", "[saveFile]") {
+  World world = generatedWorld(7);
+  vector<std::byte> bytes = encoded(world, SaveInfo{"Truncated", 0, 7, 100});
+  SaveHeader header;
+  memcpy(&header, bytes.data(), sizeof(SaveHeader));
+  SaveSection last = section(bytes, header.sectionCount - 1);
+
+  // the last section's end, not the file's - there may be padding after it
+  size_t end = last.offset + last.storedSize;
+  for (size_t size : {size_t{0}, sizeof(SaveHeader) - 1,
+                      sizeof(SaveHeader) + 1, bytes.size() / 2, end - 1}) {
+    CAPTURE(size);
+    CHECK_THROWS_AS(SaveFile(span(bytes.data(), size), "truncated"),
+                    LoadException);
+  }
+}
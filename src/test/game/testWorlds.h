@@ -0,0 +1,62 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_TEST_GAME_TESTWORLDS_H_
+#define CARRIERCONQUEST_TEST_GAME_TESTWORLDS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stop_token>
+#include <vector>
+
+#include "game/generation.h"
+#include "game/saveFile.h"
+#include "game/world.h"
+#include "util/jobSystem.h"
+#include "util/progress.h"
+
+namespace carrier_conquest::test {
+// the game's systems all run on the job system
+inline void startJobs() {
+  if (util::jobs == nullptr) util::jobs = std::make_unique<util::JobSystem>();
+}
+
+inline game::World generatedWorld(uint64_t seed) {
+  startJobs();
+  game::World world;
+  util::Progress progress;
+  game::generateCampaign(world, seed, 100, std::stop_token(), progress);
+  return world;
+}
+
+// every saved store of a world, byte for byte, as a save would hold them -
+// equal exactly when the worlds are
+inline std::vector<std::vector<std::byte>> savedState(
+    game::World const &world) {
+  game::SaveImage image;
+  game::captureSave(world, game::SaveInfo{"", 0, 0, 0}, image);
+  std::vector<std::vector<std::byte>> state;
+  for (game::SaveImage::Section &section : image.sections)
+    state.push_back(std::move(section.bytes));
+  return state;
+}
+}  // namespace carrier_conquest::test
+
+#endif  // CARRIERCONQUEST_TEST_GAME_TESTWORLDS_H_
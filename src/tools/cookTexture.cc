@@ -0,0 +1,274 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "tools/cookTexture.h"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "util/cookedTexture.h"
+
+using namespace std;
+using namespace std::filesystem;
+using namespace carrier_conquest::util;
+
+namespace carrier_conquest::tools {
+namespace {
+struct Image final {
+  uint32_t width;
+  uint32_t height;
+  vector<uint8_t> pixels;  // RGBA8
+
+  uint8_t const *at(uint32_t x, uint32_t y) const noexcept {
+    x = min(x, width - 1);
+    y = min(y, height - 1);
+    return &pixels[(size_t{y} * width + x) * 4];
+  }
+};
+
+Image downsample(Image const &image) noexcept {
+  Image result{max(image.width / 2, 1u), max(image.height / 2, 1u), {}};
+  result.pixels.resize(size_t{result.width} * result.height * 4);
+  for (uint32_t y = 0; y < result.height; ++y) {
+    for (uint32_t x = 0; x < result.width; ++x) {
+      for (size_t channel = 0; channel < 4; ++channel) {
+        unsigned sum = image.at(2 * x, 2 * y)[channel] +
+                       image.at(2 * x + 1, 2 * y)[channel] +
+                       image.at(2 * x, 2 * y + 1)[channel] +
+                       image.at(2 * x + 1, 2 * y + 1)[channel];
+        result.pixels[(size_t{y} * result.width + x) * 4 + channel] =
+            static_cast<uint8_t>((sum + 2) / 4);
+      }
+    }
+  }
+  return result;
+}
+
+unsigned distance(uint8_t const *a, array<int, 3> const &b) noexcept {
+  unsigned sum = 0;
+  for (size_t channel = 0; channel < 3; ++channel) {
+    int difference = a[channel] - b[channel];
+    sum += static_cast<unsigned>(difference * difference);
+  }
+  return sum;
+}
+
+uint16_t pack565(array<int, 3> const &colour) noexcept {
+  return static_cast<uint16_t>((colour[0] * 31 + 127) / 255 << 11 |
+                               (colour[1] * 63 + 127) / 255 << 5 |
+                               (colour[2] * 31 + 127) / 255);
+}
+
+array<int, 3> unpack565(uint16_t colour) noexcept {
+  int r = colour >> 11 & 0x1f;
+  int g = colour >> 5 & 0x3f;
+  int b = colour & 0x1f;
+  return {r << 3 | r >> 2, g << 2 | g >> 4, b << 3 | b >> 2};
+}
+
+// four-colour BC1 block from the bounding box of the block's colours
+void encodeColour(array<uint8_t const *, 16> const &block,
+                  vector<std::byte> &out) noexcept {
+  array<int, 3> low = {255, 255, 255};
+  array<int, 3> high = {0, 0, 0};
+  for (uint8_t const *pixel : block) {
+    for (size_t channel = 0; channel < 3; ++channel) {
+      low[channel] = min(low[channel], int{pixel[channel]});
+      high[channel] = max(high[channel], int{pixel[channel]});
+    }
+  }
+  for (size_t channel = 0; channel < 3; ++channel) {
+    int inset = (high[channel] - low[channel]) / 16;
+    low[channel] += inset;
+    high[channel] -= inset;
+  }
+
+  uint16_t c0 = pack565(high);
+  uint16_t c1 = pack565(low);
+  if (c0 < c1) swap(c0, c1);
+  array<array<int, 3>, 4> palette;
+  palette[0] = unpack565(c0);
+  palette[1] = unpack565(c1);
+  for (size_t channel = 0; channel < 3; ++channel) {
+    palette[2][channel] = (2 * palette[0][channel] + palette[1][channel]) / 3;
+    palette[3][channel] = (palette[0][channel] + 2 * palette[1][channel]) / 3;
+  }
+
+  uint32_t indices = 0;
+  if (c0 != c1) {
+    for (size_t idx = 0; idx < block.size(); ++idx) {
+      uint32_t best = 0;
+      for (uint32_t entry = 1; entry < palette.size(); ++entry)
+        if (distance(block[idx], palette[entry]) <
+            distance(block[idx], palette[best]))
+          best = entry;
+      indices |= best << (2 * idx);
+    }
+  }
+
+  size_t start = out.size();
+  out.resize(start + 8);
+  memcpy(&out[start], &c0, sizeof(c0));
+  memcpy(&out[start + 2], &c1, sizeof(c1));
+  memcpy(&out[start + 4], &indices, sizeof(indices));
+}
+
+// eight-value BC4 block (also the alpha half of BC3)
+void encodeChannel(array<uint8_t const *, 16> const &block, size_t channel,
+                   vector<std::byte> &out) noexcept {
+  int a0 = 0;
+  int a1 = 255;
+  for (uint8_t const *pixel : block) {
+    a0 = max(a0, int{pixel[channel]});
+    a1 = min(a1, int{pixel[channel]});
+  }
+
+  array<int, 8> palette = {a0, a1};
+  for (int step = 1; step < 7; ++step)
+    palette[static_cast<size_t>(step + 1)] =
+        ((7 - step) * a0 + step * a1 + 3) / 7;
+
+  uint64_t indices = 0;
+  if (a0 != a1) {
+    for (size_t idx = 0; idx < block.size(); ++idx) {
+      uint64_t best = 0;
+      for (uint64_t entry = 1; entry < palette.size(); ++entry)
+        if (abs(block[idx][channel] - palette[entry]) <
+            abs(block[idx][channel] - palette[best]))
+          best = entry;
+      indices |= best << (3 * idx);
+    }
+  }
+
+  size_t start = out.size();
+  out.resize(start + 8);
+  out[start] = static_cast<std::byte>(a0);
+  out[start + 1] = static_cast<std::byte>(a1);
+  memcpy(&out[start + 2], &indices, 6);
+}
+
+void encode(Image const &image, TextureFormat format,
+            vector<std::byte> &out) noexcept {
+  switch (format) {
+    case TextureFormat::RGBA8: {
+      size_t start = out.size();
+      out.resize(start + image.pixels.size());
+      memcpy(&out[start], image.pixels.data(), image.pixels.size());
+      break;
+    }
+    case TextureFormat::R8: {
+      for (size_t idx = 0; idx < image.pixels.size(); idx += 4)
+        out.push_back(static_cast<std::byte>(image.pixels[idx]));
+      break;
+    }
+    case TextureFormat::BC1:
+    case TextureFormat::BC3:
+    case TextureFormat::BC4: {
+      for (uint32_t y = 0; y < image.height; y += 4) {
+        for (uint32_t x = 0; x < image.width; x += 4) {
+          array<uint8_t const *, 16> block;
+          for (uint32_t idx = 0; idx < block.size(); ++idx)
+            block[idx] = image.at(x + idx % 4, y + idx / 4);
+
+          if (format == TextureFormat::BC3) encodeChannel(block, 3, out);
+          if (format == TextureFormat::BC4)
+            encodeChannel(block, 0, out);
+          else
+            encodeColour(block, out);
+        }
+      }
+      break;
+    }
+  }
+}
+}  // namespace
+
+vector<std::byte> cookTexture(path const &filename, bool compress) {
+  Image image;
+  {
+    int width;
+    int height;
+    stbi_set_flip_vertically_on_load(true);
+    unique_ptr<uint8_t, void (*)(void *)> data(
+        stbi_load(filename.c_str(), &width, &height, nullptr, 4),
+        stbi_image_free);
+    if (!data)
+      throw runtime_error("could not read " + filename.string() + ": " +
+                          stbi_failure_reason());
+    image.width = static_cast<uint32_t>(width);
+    image.height = static_cast<uint32_t>(height);
+    image.pixels.assign(data.get(), data.get() + size_t{image.width} *
+                                                     image.height * 4);
+  }
+
+  bool opaque = true;
+  bool grey = true;
+  for (size_t idx = 0; idx < image.pixels.size(); idx += 4) {
+    opaque = opaque && image.pixels[idx + 3] == 255;
+    grey = grey && image.pixels[idx] == image.pixels[idx + 1] &&
+           image.pixels[idx] == image.pixels[idx + 2];
+  }
+  compress = compress && image.width * image.height >= COMPRESS_AREA;
+
+  TextureFormat format;
+  if (grey && opaque)
+    format = compress ? TextureFormat::BC4 : TextureFormat::R8;
+  else if (compress)
+    format = opaque ? TextureFormat::BC1 : TextureFormat::BC3;
+  else
+    format = TextureFormat::RGBA8;
+
+  vector<Image> levels;
+  levels.push_back(move(image));
+  while (levels.back().width > 1 || levels.back().height > 1)
+    levels.push_back(downsample(levels.back()));
+
+  CookedTextureHeader header;
+  copy(begin(COOKED_TEXTURE_MAGIC), end(COOKED_TEXTURE_MAGIC), header.magic);
+  header.version = COOKED_TEXTURE_VERSION;
+  header.format = format;
+  header.width = levels.front().width;
+  header.height = levels.front().height;
+  header.levels = static_cast<uint32_t>(levels.size());
+
+  vector<CookedTextureLevel> table(levels.size());
+  vector<std::byte> out(sizeof(CookedTextureHeader) +
+                        table.size() * sizeof(CookedTextureLevel));
+  for (size_t level = 0; level < levels.size(); ++level) {
+    out.resize((out.size() + 15) / 16 * 16);
+    table[level].width = levels[level].width;
+    table[level].height = levels[level].height;
+    table[level].offset = out.size();
+    encode(levels[level], format, out);
+    table[level].size = out.size() - table[level].offset;
+  }
+
+  memcpy(out.data(), &header, sizeof(header));
+  memcpy(out.data() + sizeof(header), table.data(),
+         table.size() * sizeof(CookedTextureLevel));
+  return out;
+}
+}  // namespace carrier_conquest::tools
@@ -0,0 +1,37 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CARRIERCONQUEST_TOOLS_COOKTEXTURE_H_
+#define CARRIERCONQUEST_TOOLS_COOKTEXTURE_H_
+
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+namespace carrier_conquest::tools {
+// decodes an image and produces a cooked (.cctex) texture with a full mip
+// chain; images that are at least COMPRESS_AREA pixels in size are block
+// compressed if compress is set
+std::vector<std::byte> cookTexture(std::filesystem::path const &filename,
+                                   bool compress);
+
+constexpr unsigned long COMPRESS_AREA = 512 * 512;
+}  // namespace carrier_conquest::tools
+
+#endif  // CARRIERCONQUEST_TOOLS_COOKTEXTURE_H_
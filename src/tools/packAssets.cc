@@ -0,0 +1,128 @@
+// Copyright 2022 Justin Hu
+//
+// This file is part of Carrier Conquest.
+//
+// Carrier Conquest is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Affero General Public License as published by the
+// Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// Carrier Conquest is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Carrier Conquest. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Packs every file under an asset directory into a single indexed archive,
+// readable by carrier_conquest::util::AssetPack. Images (.tga) are cooked into
+// upload-ready .cctex textures on the way in
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "tools/cookTexture.h"
+#include "util/assetPack.h"
+
+using namespace std;
+using namespace std::filesystem;
+using namespace carrier_conquest::tools;
+using namespace carrier_conquest::util;
+
+namespace {
+struct Asset final {
+  string name;
+  vector<std::byte> data;
+};
+
+uint64_t align(uint64_t offset) {
+  return (offset + PACK_ALIGNMENT - 1) / PACK_ALIGNMENT * PACK_ALIGNMENT;
+}
+
+vector<std::byte> readFile(path const &filename) {
+  ifstream fin;
+  fin.exceptions(ifstream::failbit | ifstream::badbit);
+  fin.open(filename, ios_base::in | ios_base::binary);
+  vector<std::byte> data(file_size(filename));
+  fin.read(reinterpret_cast<char *>(data.data()),
+           static_cast<streamsize>(data.size()));
+  return data;
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  bool compress = argc == 4 && strcmp(argv[1], "--compress") == 0;
+  if (argc != 3 && !compress) {
+    cerr << "usage: " << argv[0]
+         << " [--compress] <asset directory> <output pack>" << endl;
+    return EXIT_FAILURE;
+  }
+  path root(argv[argc - 2]);
+
+  try {
+    vector<Asset> assets;
+    for (directory_entry const &entry : recursive_directory_iterator(root)) {
+      if (!entry.is_regular_file()) continue;
+      path name = entry.path().lexically_relative(root);
+      if (name.extension() == ".tga")
+        assets.push_back(
+            Asset{name.replace_extension(".cctex").generic_string(),
+                  cookTexture(entry.path(), compress)});
+      else
+        assets.push_back(Asset{name.generic_string(), readFile(entry.path())});
+    }
+    sort(assets.begin(), assets.end(), [](Asset const &a, Asset const &b) {
+      return a.name < b.name;
+    });
+
+    vector<PackEntry> entries(assets.size());
+    uint64_t offset = sizeof(PackHeader) + entries.size() * sizeof(PackEntry);
+    for (size_t idx = 0; idx < assets.size(); ++idx) {
+      entries[idx].nameOffset = offset;
+      entries[idx].nameLength = assets[idx].name.size();
+      offset += assets[idx].name.size();
+    }
+    for (size_t idx = 0; idx < assets.size(); ++idx) {
+      offset = align(offset);
+      entries[idx].dataOffset = offset;
+      entries[idx].dataSize = assets[idx].data.size();
+      offset += entries[idx].dataSize;
+    }
+
+    ofstream fout;
+    fout.exceptions(ofstream::failbit | ofstream::badbit);
+    fout.open(argv[argc - 1],
+              ios_base::out | ios_base::binary | ios_base::trunc);
+
+    PackHeader header;
+    copy(begin(PACK_MAGIC), end(PACK_MAGIC), header.magic);
+    header.version = PACK_VERSION;
+    header.count = entries.size();
+    fout.write(reinterpret_cast<char const *>(&header), sizeof(header));
+    fout.write(reinterpret_cast<char const *>(entries.data()),
+               static_cast<streamsize>(entries.size() * sizeof(PackEntry)));
+    for (Asset const &asset : assets)
+      fout.write(asset.name.data(), static_cast<streamsize>(asset.name.size()));
+    for (size_t idx = 0; idx < assets.size(); ++idx) {
+      while (static_cast<uint64_t>(fout.tellp()) < entries[idx].dataOffset)
+        fout.put('\0');
+      fout.write(reinterpret_cast<char const *>(assets[idx].data.data()),
+                 static_cast<streamsize>(assets[idx].data.size()));
+    }
+  } catch (exception const &e) {
+    cerr << "ERROR: Could not pack assets: " << e.what() << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}